@@ -74,3 +74,13 @@ void BraveBrowserMainExtraParts::PreMainMessageLoopRun() {
   brave::BraveUptimeTracker::CreateInstance(g_browser_process->local_state());
 #endif  // !defined(OS_ANDROID)
 }
+
+void BraveBrowserMainExtraParts::PostMainMessageLoopRun() {
+#if BUILDFLAG(BRAVE_P3A_ENABLED)
+  g_brave_browser_process->brave_p3a_service()->OnShutdown();
+#endif  // BUILDFLAG(BRAVE_P3A_ENABLED)
+
+#if !defined(OS_ANDROID)
+  brave::BraveUptimeTracker::ShutdownInstance();
+#endif  // !defined(OS_ANDROID)
+}
@@ -19,6 +19,7 @@ class BraveBrowserMainExtraParts : public ChromeBrowserMainExtraParts {
   // ChromeBrowserMainExtraParts overrides.
   void PostBrowserStart() override;
   void PreMainMessageLoopRun() override;
+  void PostMainMessageLoopRun() override;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(BraveBrowserMainExtraParts);
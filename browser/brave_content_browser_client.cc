@@ -30,6 +30,7 @@
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_wallet/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
+#include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/services/brave_content_browser_overlay_manifest.h"
 #include "brave/components/speedreader/buildflags.h"
 #include "brave/grit/brave_generated_resources.h"
@@ -84,6 +85,10 @@ using extensions::ChromeContentBrowserClientExtensionsPart;
 #include "brave/components/brave_rewards/browser/rewards_protocol_handler.h"
 #endif
 
+#if BUILDFLAG(ENABLE_GREASELION)
+#include "brave/browser/greaselion/greaselion_navigation_throttle.h"
+#endif
+
 #if BUILDFLAG(ENABLE_TOR)
 #include "brave/browser/tor/tor_navigation_throttle.h"
 #include "brave/browser/tor/tor_profile_service_factory.h"
@@ -467,5 +472,12 @@ BraveContentBrowserClient::CreateThrottlesForNavigation(
     throttles.push_back(std::move(tor_navigation_throttle));
 #endif
 
+#if BUILDFLAG(ENABLE_GREASELION)
+  std::unique_ptr<content::NavigationThrottle> greaselion_navigation_throttle =
+      greaselion::GreaselionNavigationThrottle::MaybeCreateThrottleFor(handle);
+  if (greaselion_navigation_throttle)
+    throttles.push_back(std::move(greaselion_navigation_throttle));
+#endif
+
   return throttles;
 }
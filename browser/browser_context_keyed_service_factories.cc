@@ -15,6 +15,7 @@
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/browser/ntp_background_images/view_counter_service_factory.h"
 #include "brave/components/brave_wallet/browser/buildflags/buildflags.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 
 #if BUILDFLAG(ENABLE_GREASELION)
 #include "brave/browser/greaselion/greaselion_service_factory.h"
@@ -44,6 +45,7 @@ void EnsureBrowserContextKeyedServiceFactoriesBuilt() {
   SearchEngineProviderServiceFactory::GetInstance();
   SearchEngineTrackerFactory::GetInstance();
   ntp_background_images::ViewCounterServiceFactory::GetInstance();
+  WeeklyStorageRegistryFactory::GetInstance();
 
 #if !defined(OS_ANDROID)
   BookmarkPrefsServiceFactory::GetInstance();
@@ -117,7 +117,7 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
   }
 
   void ClearRules() {
-    g_brave_browser_process->greaselion_download_service()->rules()->clear();
+    g_brave_browser_process->greaselion_download_service()->ClearRules();
   }
 
   void SetRewardsEnabled(bool enabled) {
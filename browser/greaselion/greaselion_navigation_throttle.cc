@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/greaselion/greaselion_navigation_throttle.h"
+
+#include "base/bind.h"
+#include "brave/browser/greaselion/greaselion_service_factory.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents.h"
+
+namespace greaselion {
+
+// static
+std::unique_ptr<GreaselionNavigationThrottle>
+GreaselionNavigationThrottle::MaybeCreateThrottleFor(
+    content::NavigationHandle* navigation_handle) {
+  // Greaselion scripts only run in the main frame.
+  if (!navigation_handle->IsInMainFrame())
+    return nullptr;
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(
+          navigation_handle->GetWebContents()->GetBrowserContext());
+  if (!greaselion_service)
+    return nullptr;
+  return std::make_unique<GreaselionNavigationThrottle>(navigation_handle,
+                                                        greaselion_service);
+}
+
+GreaselionNavigationThrottle::GreaselionNavigationThrottle(
+    content::NavigationHandle* navigation_handle,
+    GreaselionService* greaselion_service)
+    : content::NavigationThrottle(navigation_handle),
+      greaselion_service_(greaselion_service) {}
+
+GreaselionNavigationThrottle::~GreaselionNavigationThrottle() {
+  if (deferred_)
+    greaselion_service_->RemoveObserver(this);
+}
+
+content::NavigationThrottle::ThrottleCheckResult
+GreaselionNavigationThrottle::WillStartRequest() {
+  return MaybeDefer();
+}
+
+content::NavigationThrottle::ThrottleCheckResult
+GreaselionNavigationThrottle::WillRedirectRequest() {
+  return MaybeDefer();
+}
+
+const char* GreaselionNavigationThrottle::GetNameForLogging() {
+  return "GreaselionNavigationThrottle";
+}
+
+content::NavigationThrottle::ThrottleCheckResult
+GreaselionNavigationThrottle::MaybeDefer() {
+  if (!greaselion_service_->ActivateRulesForURL(navigation_handle()->GetURL()))
+    return content::NavigationThrottle::PROCEED;
+  deferred_ = true;
+  greaselion_service_->AddObserver(this);
+  install_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromSeconds(kInstallTimeoutSeconds),
+      base::BindOnce(&GreaselionNavigationThrottle::ResumeIfDeferred,
+                     base::Unretained(this)));
+  return content::NavigationThrottle::DEFER;
+}
+
+void GreaselionNavigationThrottle::OnExtensionsReady(
+    GreaselionService* greaselion_service,
+    bool success) {
+  ResumeIfDeferred();
+}
+
+void GreaselionNavigationThrottle::ResumeIfDeferred() {
+  if (!deferred_)
+    return;
+  deferred_ = false;
+  install_timer_.Stop();
+  greaselion_service_->RemoveObserver(this);
+  // May delete |this|.
+  Resume();
+}
+
+}  // namespace greaselion
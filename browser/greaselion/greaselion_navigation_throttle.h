@@ -0,0 +1,59 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_GREASELION_GREASELION_NAVIGATION_THROTTLE_H_
+#define BRAVE_BROWSER_GREASELION_GREASELION_NAVIGATION_THROTTLE_H_
+
+#include <memory>
+
+#include "base/timer/timer.h"
+#include "brave/components/greaselion/browser/greaselion_service.h"
+#include "content/public/browser/navigation_throttle.h"
+
+namespace content {
+class NavigationHandle;
+}  // namespace content
+
+namespace greaselion {
+
+// Activates the Greaselion rules matching main frame navigations and holds
+// the navigation back until their extensions are installed, so the scripts
+// run on the first visit to a site as well.
+class GreaselionNavigationThrottle : public content::NavigationThrottle,
+                                     public GreaselionService::Observer {
+ public:
+  // Longest time a navigation is held back, then it proceeds without waiting
+  // for the extensions any longer.
+  static constexpr int kInstallTimeoutSeconds = 10;
+
+  static std::unique_ptr<GreaselionNavigationThrottle>
+    MaybeCreateThrottleFor(content::NavigationHandle* navigation_handle);
+  GreaselionNavigationThrottle(content::NavigationHandle* navigation_handle,
+                               GreaselionService* greaselion_service);
+  ~GreaselionNavigationThrottle() override;
+
+  // content::NavigationThrottle implementation:
+  ThrottleCheckResult WillStartRequest() override;
+  ThrottleCheckResult WillRedirectRequest() override;
+  const char* GetNameForLogging() override;
+
+ private:
+  ThrottleCheckResult MaybeDefer();
+  void ResumeIfDeferred();
+
+  // GreaselionService::Observer implementation
+  void OnExtensionsReady(GreaselionService* greaselion_service,
+                         bool success) override;
+
+  GreaselionService* greaselion_service_;  // NOT OWNED
+  bool deferred_ = false;
+  base::OneShotTimer install_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(GreaselionNavigationThrottle);
+};
+
+}  // namespace greaselion
+
+#endif  // BRAVE_BROWSER_GREASELION_GREASELION_NAVIGATION_THROTTLE_H_
@@ -0,0 +1,157 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/greaselion/greaselion_navigation_throttle.h"
+
+#include <memory>
+
+#include "base/observer_list.h"
+#include "base/test/bind_test_util.h"
+#include "brave/components/greaselion/browser/greaselion_service.h"
+#include "content/public/browser/navigation_throttle.h"
+#include "content/public/test/browser_task_environment.h"
+#include "content/public/test/mock_navigation_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using content::NavigationThrottle;
+
+namespace greaselion {
+
+namespace {
+
+// Reports pending extensions for every URL until the test marks them ready,
+// the way GreaselionServiceImpl does while it installs them.
+class FakeGreaselionService : public GreaselionService {
+ public:
+  FakeGreaselionService() = default;
+  ~FakeGreaselionService() override = default;
+
+  void SetFeatureEnabled(GreaselionFeature feature, bool enabled) override {}
+  void UpdateInstalledExtensions() override {}
+  bool ActivateRulesForURL(const GURL& url) override { return !ready_; }
+  bool ready() override { return ready_; }
+  void AddObserver(Observer* observer) override {
+    observers_.AddObserver(observer);
+  }
+  void RemoveObserver(Observer* observer) override {
+    observers_.RemoveObserver(observer);
+  }
+
+  void SetReady() {
+    ready_ = true;
+    for (auto& observer : observers_)
+      observer.OnExtensionsReady(this, true);
+  }
+
+  bool HasObservers() const { return observers_.might_have_observers(); }
+
+ private:
+  bool ready_ = false;
+  base::ObserverList<Observer> observers_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeGreaselionService);
+};
+
+}  // namespace
+
+class GreaselionNavigationThrottleUnitTest : public testing::Test {
+ public:
+  GreaselionNavigationThrottleUnitTest() = default;
+  ~GreaselionNavigationThrottleUnitTest() override = default;
+
+  content::BrowserTaskEnvironment* task_environment() {
+    return &task_environment_;
+  }
+
+  // Creates a throttle for a main frame navigation which reports when it is
+  // resumed.
+  std::unique_ptr<GreaselionNavigationThrottle> CreateThrottle(
+      content::MockNavigationHandle* handle,
+      FakeGreaselionService* service,
+      bool* resumed) {
+    handle->set_url(GURL("https://www.example.com"));
+    auto throttle =
+        std::make_unique<GreaselionNavigationThrottle>(handle, service);
+    throttle->set_resume_callback_for_testing(
+        base::BindLambdaForTesting([resumed]() { *resumed = true; }));
+    return throttle;
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+
+  DISALLOW_COPY_AND_ASSIGN(GreaselionNavigationThrottleUnitTest);
+};
+
+TEST_F(GreaselionNavigationThrottleUnitTest, ProceedsWhenReady) {
+  FakeGreaselionService service;
+  service.SetReady();
+  content::MockNavigationHandle test_handle;
+  bool resumed = false;
+  std::unique_ptr<GreaselionNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::PROCEED, throttle->WillStartRequest().action());
+  EXPECT_FALSE(service.HasObservers());
+  EXPECT_FALSE(resumed);
+}
+
+TEST_F(GreaselionNavigationThrottleUnitTest, ResumesWhenExtensionsAreReady) {
+  FakeGreaselionService service;
+  content::MockNavigationHandle test_handle;
+  bool resumed = false;
+  std::unique_ptr<GreaselionNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+  EXPECT_FALSE(resumed);
+
+  service.SetReady();
+  EXPECT_TRUE(resumed);
+  EXPECT_FALSE(service.HasObservers());
+
+  // The timer was stopped, so the navigation isn't resumed again.
+  resumed = false;
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(
+      GreaselionNavigationThrottle::kInstallTimeoutSeconds));
+  EXPECT_FALSE(resumed);
+}
+
+TEST_F(GreaselionNavigationThrottleUnitTest, ResumesWhenInstallStalls) {
+  FakeGreaselionService service;
+  content::MockNavigationHandle test_handle;
+  bool resumed = false;
+  std::unique_ptr<GreaselionNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(
+      GreaselionNavigationThrottle::kInstallTimeoutSeconds - 1));
+  EXPECT_FALSE(resumed);
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(resumed);
+  EXPECT_FALSE(service.HasObservers());
+
+  // Extensions getting ready after the timeout don't resume it again.
+  resumed = false;
+  service.SetReady();
+  EXPECT_FALSE(resumed);
+}
+
+TEST_F(GreaselionNavigationThrottleUnitTest, DefersRedirects) {
+  FakeGreaselionService service;
+  content::MockNavigationHandle test_handle;
+  bool resumed = false;
+  std::unique_ptr<GreaselionNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER,
+            throttle->WillRedirectRequest().action());
+
+  service.SetReady();
+  EXPECT_TRUE(resumed);
+}
+
+}  // namespace greaselion
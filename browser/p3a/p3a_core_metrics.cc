@@ -97,6 +97,11 @@ void BraveUptimeTracker::CreateInstance(PrefService* local_state) {
   g_brave_uptime_tracker_instance = new BraveUptimeTracker(local_state);
 }
 
+void BraveUptimeTracker::ShutdownInstance() {
+  delete g_brave_uptime_tracker_instance;
+  g_brave_uptime_tracker_instance = nullptr;
+}
+
 void BraveUptimeTracker::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterListPref(kDailyUptimesListPrefName);
 }
@@ -24,6 +24,9 @@ class BraveUptimeTracker {
   ~BraveUptimeTracker();
 
   static void CreateInstance(PrefService* local_state);
+  // Destroys the instance while |local_state| is still alive, so the uptime
+  // which was not saved yet is written to prefs.
+  static void ShutdownInstance();
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
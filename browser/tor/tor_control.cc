@@ -0,0 +1,428 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/tor/tor_control.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "brave/common/tor/tor_constants.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log_source.h"
+#include "net/socket/tcp_client_socket.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+
+namespace tor {
+
+namespace {
+
+constexpr base::TimeDelta kReadControlFilesRetryDelay =
+    base::TimeDelta::FromMilliseconds(500);
+// Tor writes the control files once it has opened the control port, which
+// normally takes a few seconds after launch.
+constexpr int kMaxReadControlFilesAttempts = 60;
+constexpr int kReadBufferSize = 4096;
+constexpr size_t kMaxLineLength = 64 * 1024;
+
+constexpr char kLineEnd[] = "\r\n";
+constexpr int kStatusOk = 250;
+constexpr int kStatusEvent = 650;
+
+constexpr char kControlPortPrefix[] = "PORT=";
+constexpr char kBootstrapPhasePrefix[] = "status/bootstrap-phase=";
+constexpr char kStatusClientEvent[] = "STATUS_CLIENT ";
+constexpr char kCircuitEvent[] = "CIRC ";
+
+net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotation() {
+  return net::DefineNetworkTrafficAnnotation("tor_control", R"(
+      semantics {
+        sender: "Tor Control"
+        description:
+          "Talks to the local tor process over its control port to learn "
+          "when it is connected to the Tor network."
+        trigger:
+          "Tor process is launched for a private window with Tor."
+        data:
+          "Authentication cookie written by tor and tor control commands."
+        destination: LOCAL
+      }
+      policy {
+        cookies_allowed: NO
+        setting:
+          "Users can disable Tor in brave://settings/extensions"
+         policy_exception_justification:
+           "Not implemented."
+      })");
+}
+
+// Returns the value of |key| in a tor status line like
+// NOTICE BOOTSTRAP PROGRESS=50 TAG=loading_descriptors SUMMARY="Loading".
+std::string GetStatusArgument(const std::string& status,
+                              const std::string& key) {
+  const std::string prefix = " " + key + "=";
+  size_t begin = status.find(prefix);
+  if (begin == std::string::npos)
+    return std::string();
+  begin += prefix.length();
+
+  if (begin < status.length() && status[begin] == '"') {
+    const size_t end = status.find('"', begin + 1);
+    if (end == std::string::npos)
+      return std::string();
+    return status.substr(begin + 1, end - begin - 1);
+  }
+  const size_t end = status.find(' ', begin);
+  return status.substr(
+      begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+
+}  // namespace
+
+struct TorControl::ControlInfo {
+  net::IPEndPoint endpoint;
+  std::string cookie;
+};
+
+TorControl::TorControl(
+    base::WeakPtr<Delegate> delegate,
+    scoped_refptr<base::SequencedTaskRunner> delegate_task_runner)
+    : delegate_(std::move(delegate)),
+      delegate_task_runner_(std::move(delegate_task_runner)) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+TorControl::~TorControl() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void TorControl::Start(const base::FilePath& watch_dir) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Stop();
+  watch_dir_ = watch_dir;
+  read_attempts_ = 0;
+  ReadControlFiles();
+}
+
+void TorControl::Stop() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  retry_timer_.Stop();
+  socket_.reset();
+  read_buffer_ = nullptr;
+  pending_input_.clear();
+  write_buffer_ = nullptr;
+  pending_output_.clear();
+  pending_commands_.clear();
+  reply_lines_.clear();
+  reading_data_ = false;
+}
+
+// static
+base::Optional<TorControl::ControlInfo> TorControl::ReadControlInfo(
+    const base::FilePath& watch_dir) {
+  std::string port;
+  if (!base::ReadFileToString(watch_dir.Append(kTorControlPortFile), &port))
+    return base::nullopt;
+
+  // The file has a single PORT=127.0.0.1:9051 line.
+  port = base::TrimWhitespaceASCII(port, base::TRIM_ALL).as_string();
+  const size_t colon = port.rfind(':');
+  if (!base::StartsWith(port, kControlPortPrefix,
+                        base::CompareCase::SENSITIVE) ||
+      colon == std::string::npos) {
+    return base::nullopt;
+  }
+  net::IPAddress address;
+  int port_number = 0;
+  const size_t prefix_length = sizeof(kControlPortPrefix) - 1;
+  if (!address.AssignFromIPLiteral(base::StringPiece(port).substr(
+          prefix_length, colon - prefix_length)) ||
+      !base::StringToInt(base::StringPiece(port).substr(colon + 1),
+                         &port_number) ||
+      port_number <= 0 || port_number > 65535) {
+    return base::nullopt;
+  }
+
+  ControlInfo info;
+  info.endpoint = net::IPEndPoint(address, port_number);
+  if (!base::ReadFileToString(watch_dir.Append(kTorControlCookieFile),
+                              &info.cookie) ||
+      info.cookie.empty()) {
+    return base::nullopt;
+  }
+  return info;
+}
+
+void TorControl::ReadControlFiles() {
+  read_attempts_++;
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&TorControl::ReadControlInfo, watch_dir_),
+      base::BindOnce(&TorControl::OnReadControlFiles,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void TorControl::OnReadControlFiles(base::Optional<ControlInfo> info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!info) {
+    if (read_attempts_ >= kMaxReadControlFilesAttempts) {
+      LOG(ERROR) << "Tor control port is not available";
+      Close();
+      return;
+    }
+    retry_timer_.Start(FROM_HERE, kReadControlFilesRetryDelay, this,
+                       &TorControl::ReadControlFiles);
+    return;
+  }
+
+  socket_ = std::make_unique<net::TCPClientSocket>(
+      net::AddressList(info->endpoint), nullptr, nullptr, net::NetLogSource());
+  int rv = socket_->Connect(base::BindOnce(&TorControl::OnConnected,
+                                           weak_ptr_factory_.GetWeakPtr(),
+                                           info->cookie));
+  if (rv != net::ERR_IO_PENDING)
+    OnConnected(info->cookie, rv);
+}
+
+void TorControl::OnConnected(const std::string& cookie, int rv) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (rv != net::OK) {
+    LOG(ERROR) << "Failed to connect to tor control port: "
+               << net::ErrorToString(rv);
+    Close();
+    return;
+  }
+
+  read_buffer_ = base::MakeRefCounted<net::IOBufferWithSize>(kReadBufferSize);
+  SendCommand("AUTHENTICATE " + base::HexEncode(cookie.data(), cookie.size()),
+              base::BindOnce(&TorControl::OnAuthenticated,
+                             base::Unretained(this)));
+  DoRead();
+}
+
+void TorControl::OnAuthenticated(int status, std::vector<std::string> lines) {
+  if (status != kStatusOk) {
+    LOG(ERROR) << "Tor control authentication failed: " << status;
+    Close();
+    return;
+  }
+  SendCommand("SETEVENTS STATUS_CLIENT CIRC",
+              base::BindOnce(&TorControl::OnSubscribed,
+                             base::Unretained(this)));
+}
+
+void TorControl::OnSubscribed(int status, std::vector<std::string> lines) {
+  if (status != kStatusOk) {
+    LOG(ERROR) << "Tor control events subscription failed: " << status;
+    Close();
+    return;
+  }
+  delegate_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Delegate::OnTorControlReady, delegate_));
+
+  // Events only report changes, so ask where bootstrap is now.
+  SendCommand("GETINFO status/bootstrap-phase",
+              base::BindOnce(&TorControl::OnGotBootstrapPhase,
+                             base::Unretained(this)));
+}
+
+void TorControl::OnGotBootstrapPhase(int status,
+                                     std::vector<std::string> lines) {
+  if (status != kStatusOk)
+    return;
+  for (const std::string& line : lines) {
+    if (base::StartsWith(line, kBootstrapPhasePrefix,
+                         base::CompareCase::SENSITIVE)) {
+      HandleBootstrapStatus(line.substr(sizeof(kBootstrapPhasePrefix) - 1));
+    }
+  }
+}
+
+void TorControl::SendCommand(const std::string& command,
+                             CommandCallback callback) {
+  DCHECK(socket_);
+  pending_commands_.push_back(std::move(callback));
+  pending_output_ += command + kLineEnd;
+  if (!write_buffer_)
+    DoWrite();
+}
+
+void TorControl::DoWrite() {
+  while (socket_) {
+    if (!write_buffer_) {
+      if (pending_output_.empty())
+        return;
+      const int size = pending_output_.size();
+      write_buffer_ = base::MakeRefCounted<net::DrainableIOBuffer>(
+          base::MakeRefCounted<net::StringIOBuffer>(std::move(pending_output_)),
+          size);
+      pending_output_.clear();
+    }
+
+    int rv = socket_->Write(
+        write_buffer_.get(), write_buffer_->BytesRemaining(),
+        base::BindOnce(&TorControl::OnWritten, weak_ptr_factory_.GetWeakPtr()),
+        GetNetworkTrafficAnnotation());
+    if (rv == net::ERR_IO_PENDING)
+      return;
+    HandleWrite(rv);
+  }
+}
+
+void TorControl::OnWritten(int rv) {
+  HandleWrite(rv);
+  DoWrite();
+}
+
+void TorControl::HandleWrite(int rv) {
+  if (rv < 0) {
+    Close();
+    return;
+  }
+  write_buffer_->DidConsume(rv);
+  if (write_buffer_->BytesRemaining() == 0)
+    write_buffer_ = nullptr;
+}
+
+void TorControl::DoRead() {
+  while (socket_) {
+    int rv = socket_->Read(
+        read_buffer_.get(), read_buffer_->size(),
+        base::BindOnce(&TorControl::OnRead, weak_ptr_factory_.GetWeakPtr()));
+    if (rv == net::ERR_IO_PENDING || !HandleRead(rv))
+      return;
+  }
+}
+
+void TorControl::OnRead(int rv) {
+  if (HandleRead(rv))
+    DoRead();
+}
+
+bool TorControl::HandleRead(int rv) {
+  if (rv <= 0) {
+    // Tor closed the connection, which happens when it exits.
+    Close();
+    return false;
+  }
+
+  pending_input_.append(read_buffer_->data(), rv);
+  size_t line_end;
+  while (socket_ &&
+         (line_end = pending_input_.find(kLineEnd)) != std::string::npos) {
+    const std::string line = pending_input_.substr(0, line_end);
+    pending_input_.erase(0, line_end + sizeof(kLineEnd) - 1);
+    HandleLine(line);
+  }
+
+  if (pending_input_.length() > kMaxLineLength) {
+    LOG(ERROR) << "Tor control line is too long";
+    Close();
+  }
+  return !!socket_;
+}
+
+void TorControl::HandleLine(const std::string& line) {
+  // Lines of a data block follow a "+" line and end with a single dot.
+  if (reading_data_) {
+    if (line == ".")
+      reading_data_ = false;
+    else
+      reply_lines_.push_back(line);
+    return;
+  }
+
+  // Every other line is a status code followed by a separator: "-" for
+  // a middle line, "+" for a data block and " " for the end of a reply.
+  int status = 0;
+  if (line.length() < 4 ||
+      !base::StringToInt(base::StringPiece(line).substr(0, 3), &status)) {
+    LOG(ERROR) << "Malformed tor control line: " << line;
+    Close();
+    return;
+  }
+  const char separator = line[3];
+  const std::string text = line.substr(4);
+
+  if (status == kStatusEvent) {
+    if (separator == ' ')
+      HandleEvent(text);
+    return;
+  }
+
+  reply_lines_.push_back(text);
+  if (separator == '+') {
+    reading_data_ = true;
+    return;
+  }
+  if (separator != ' ')
+    return;
+
+  if (pending_commands_.empty()) {
+    LOG(ERROR) << "Unexpected tor control reply: " << line;
+    Close();
+    return;
+  }
+  CommandCallback callback = std::move(pending_commands_.front());
+  pending_commands_.pop_front();
+  std::move(callback).Run(status, std::move(reply_lines_));
+  reply_lines_.clear();
+}
+
+void TorControl::HandleEvent(const std::string& event) {
+  if (base::StartsWith(event, kStatusClientEvent,
+                       base::CompareCase::SENSITIVE)) {
+    HandleBootstrapStatus(event.substr(sizeof(kStatusClientEvent) - 1));
+    return;
+  }
+
+  if (base::StartsWith(event, kCircuitEvent, base::CompareCase::SENSITIVE)) {
+    // CIRC <id> <status> [<path>] [<key>=<value> ...]
+    const std::string circuit = event.substr(sizeof(kCircuitEvent) - 1);
+    const size_t id_end = circuit.find(' ');
+    if (id_end == std::string::npos)
+      return;
+    const size_t status_end = circuit.find(' ', id_end + 1);
+    delegate_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Delegate::OnTorCircuitEvent, delegate_,
+                       circuit.substr(0, id_end),
+                       circuit.substr(id_end + 1,
+                                      status_end == std::string::npos
+                                          ? std::string::npos
+                                          : status_end - id_end - 1)));
+  }
+}
+
+void TorControl::HandleBootstrapStatus(const std::string& status) {
+  // <severity> BOOTSTRAP PROGRESS=<num> TAG=<tag> SUMMARY=<summary> ...
+  if (status.find(" BOOTSTRAP ") == std::string::npos)
+    return;
+
+  int progress = 0;
+  if (!base::StringToInt(GetStatusArgument(status, "PROGRESS"), &progress))
+    return;
+  delegate_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Delegate::OnTorBootstrapProgress, delegate_, progress,
+                     GetStatusArgument(status, "SUMMARY")));
+}
+
+void TorControl::Close() {
+  Stop();
+  delegate_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Delegate::OnTorControlClosed, delegate_));
+}
+
+}  // namespace tor
@@ -0,0 +1,124 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_TOR_TOR_CONTROL_H_
+#define BRAVE_BROWSER_TOR_TOR_CONTROL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+#include "base/timer/timer.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace net {
+class DrainableIOBuffer;
+class IOBufferWithSize;
+class StreamSocket;
+}  // namespace net
+
+namespace tor {
+
+// Minimal asynchronous client of the tor control protocol. It connects to the
+// control port tor writes to the watch directory, authenticates with the
+// cookie and subscribes to bootstrap status and circuit events.
+// Lives on a sequence which can do network IO; delegate methods are posted to
+// |delegate_task_runner|.
+class TorControl {
+ public:
+  class Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    // Authenticated and subscribed to events.
+    virtual void OnTorControlReady() = 0;
+    // Connection to the control port failed or was closed by tor.
+    virtual void OnTorControlClosed() = 0;
+    // |progress| is in percents, 100 means tor can carry traffic.
+    virtual void OnTorBootstrapProgress(int progress,
+                                        const std::string& summary) = 0;
+    // |status| is LAUNCHED, BUILT, EXTENDED, FAILED or CLOSED.
+    virtual void OnTorCircuitEvent(const std::string& circuit_id,
+                                   const std::string& status) = 0;
+  };
+
+  TorControl(base::WeakPtr<Delegate> delegate,
+             scoped_refptr<base::SequencedTaskRunner> delegate_task_runner);
+  ~TorControl();
+
+  // Connects to the tor which was launched with |watch_dir|. Tor writes the
+  // control files some time after launch, so they are polled for a while.
+  void Start(const base::FilePath& watch_dir);
+  // Closes the connection without notifying the delegate.
+  void Stop();
+
+ private:
+  struct ControlInfo;
+  using CommandCallback =
+      base::OnceCallback<void(int status, std::vector<std::string> lines)>;
+
+  // Reads the control port and the cookie tor wrote to |watch_dir|.
+  static base::Optional<ControlInfo> ReadControlInfo(
+      const base::FilePath& watch_dir);
+
+  void ReadControlFiles();
+  void OnReadControlFiles(base::Optional<ControlInfo> info);
+  void OnConnected(const std::string& cookie, int rv);
+  void OnAuthenticated(int status, std::vector<std::string> lines);
+  void OnSubscribed(int status, std::vector<std::string> lines);
+  void OnGotBootstrapPhase(int status, std::vector<std::string> lines);
+
+  void SendCommand(const std::string& command, CommandCallback callback);
+  void DoWrite();
+  void OnWritten(int rv);
+  void HandleWrite(int rv);
+
+  void DoRead();
+  void OnRead(int rv);
+  bool HandleRead(int rv);
+  void HandleLine(const std::string& line);
+  void HandleEvent(const std::string& event);
+  void HandleBootstrapStatus(const std::string& status);
+
+  // Closes the connection and notifies the delegate.
+  void Close();
+
+  base::WeakPtr<Delegate> delegate_;
+  scoped_refptr<base::SequencedTaskRunner> delegate_task_runner_;
+
+  base::FilePath watch_dir_;
+  int read_attempts_ = 0;
+  base::OneShotTimer retry_timer_;
+
+  std::unique_ptr<net::StreamSocket> socket_;
+  scoped_refptr<net::IOBufferWithSize> read_buffer_;
+  std::string pending_input_;
+  scoped_refptr<net::DrainableIOBuffer> write_buffer_;
+  std::string pending_output_;
+  // Callbacks of sent commands waiting for their replies, in order.
+  base::circular_deque<CommandCallback> pending_commands_;
+  std::vector<std::string> reply_lines_;
+  bool reading_data_ = false;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<TorControl> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(TorControl);
+};
+
+}  // namespace tor
+
+#endif  // BRAVE_BROWSER_TOR_TOR_CONTROL_H_
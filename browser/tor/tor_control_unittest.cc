@@ -0,0 +1,364 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/tor/tor_control.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "brave/common/tor/tor_constants.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log_source.h"
+#include "net/socket/stream_socket.h"
+#include "net/socket/tcp_server_socket.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=TorControlTest.*
+
+namespace tor {
+
+namespace {
+
+const char kCookie[] = "\x01\x23\x45\x67\x89\xab\xcd\xef\x10\x32\x54\x76"
+                       "\x98\xba\xdc\xfe\x00\x11\x22\x33\x44\x55\x66\x77"
+                       "\x88\x99\xaa\xbb\xcc\xdd\xee\xff";
+
+std::string GetCookie() {
+  return std::string(kCookie, sizeof(kCookie) - 1);
+}
+
+// Speaks just enough of the tor control protocol to authenticate a client
+// and report bootstrap status. Events are scripted with SendLine().
+class FakeTorControlServer {
+ public:
+  FakeTorControlServer() = default;
+  ~FakeTorControlServer() = default;
+
+  bool Start() {
+    server_socket_ =
+        std::make_unique<net::TCPServerSocket>(nullptr, net::NetLogSource());
+    if (server_socket_->Listen(
+            net::IPEndPoint(net::IPAddress::IPv4Localhost(), 0), 1) !=
+            net::OK ||
+        server_socket_->GetLocalAddress(&endpoint_) != net::OK) {
+      return false;
+    }
+    DoAccept();
+    return true;
+  }
+
+  // Writes the files tor writes for control port clients to |dir|.
+  bool WriteControlFiles(const base::FilePath& dir,
+                         const std::string& cookie) {
+    const std::string port = "PORT=" + endpoint_.ToString() + "\n";
+    return base::WriteFile(dir.Append(kTorControlPortFile), port.data(),
+                           port.size()) == static_cast<int>(port.size()) &&
+           base::WriteFile(dir.Append(kTorControlCookieFile), cookie.data(),
+                           cookie.size()) == static_cast<int>(cookie.size());
+  }
+
+  void SendLine(const std::string& line) {
+    ASSERT_TRUE(socket_);
+    const std::string data = line + "\r\n";
+    auto buffer = base::MakeRefCounted<net::StringIOBuffer>(data);
+    // Writes this small to a localhost socket complete at once.
+    EXPECT_EQ(static_cast<int>(data.size()),
+              socket_->Write(buffer.get(), data.size(), base::DoNothing(),
+                             TRAFFIC_ANNOTATION_FOR_TESTS));
+  }
+
+  void CloseConnection() { socket_.reset(); }
+
+  void set_bootstrap_phase(const std::string& phase) {
+    bootstrap_phase_ = phase;
+  }
+  const std::vector<std::string>& commands() const { return commands_; }
+
+ private:
+  void DoAccept() {
+    int rv = server_socket_->Accept(
+        &socket_, base::BindOnce(&FakeTorControlServer::OnAccepted,
+                                 base::Unretained(this)));
+    if (rv != net::ERR_IO_PENDING)
+      OnAccepted(rv);
+  }
+
+  void OnAccepted(int rv) {
+    ASSERT_EQ(net::OK, rv);
+    read_buffer_ = base::MakeRefCounted<net::IOBufferWithSize>(1024);
+    DoRead();
+  }
+
+  void DoRead() {
+    while (socket_) {
+      int rv = socket_->Read(read_buffer_.get(), read_buffer_->size(),
+                             base::BindOnce(&FakeTorControlServer::OnRead,
+                                            base::Unretained(this)));
+      if (rv == net::ERR_IO_PENDING)
+        return;
+      HandleRead(rv);
+    }
+  }
+
+  void OnRead(int rv) {
+    HandleRead(rv);
+    DoRead();
+  }
+
+  void HandleRead(int rv) {
+    if (rv <= 0) {
+      socket_.reset();
+      return;
+    }
+    input_.append(read_buffer_->data(), rv);
+    size_t end;
+    while (socket_ && (end = input_.find("\r\n")) != std::string::npos) {
+      const std::string command = input_.substr(0, end);
+      input_.erase(0, end + 2);
+      HandleCommand(command);
+    }
+  }
+
+  void HandleCommand(const std::string& command) {
+    commands_.push_back(command);
+    const std::string cookie = GetCookie();
+    if (base::StartsWith(command, "AUTHENTICATE ",
+                         base::CompareCase::SENSITIVE)) {
+      SendLine(command == "AUTHENTICATE " +
+                              base::HexEncode(cookie.data(), cookie.size())
+                   ? "250 OK"
+                   : "515 Authentication failed: Wrong length on "
+                     "authentication cookie.");
+    } else if (command == "SETEVENTS STATUS_CLIENT CIRC") {
+      SendLine("250 OK");
+    } else if (command == "GETINFO status/bootstrap-phase") {
+      SendLine("250-status/bootstrap-phase=" + bootstrap_phase_);
+      SendLine("250 OK");
+    } else {
+      SendLine("510 Unrecognized command \"" + command + "\"");
+    }
+  }
+
+  std::unique_ptr<net::TCPServerSocket> server_socket_;
+  net::IPEndPoint endpoint_;
+  std::unique_ptr<net::StreamSocket> socket_;
+  scoped_refptr<net::IOBufferWithSize> read_buffer_;
+  std::string input_;
+  std::string bootstrap_phase_ =
+      "NOTICE BOOTSTRAP PROGRESS=0 TAG=starting SUMMARY=\"Starting\"";
+  std::vector<std::string> commands_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeTorControlServer);
+};
+
+class TestDelegate : public TorControl::Delegate {
+ public:
+  TestDelegate() = default;
+  ~TestDelegate() override = default;
+
+  // Runs until |condition| holds after one of the notifications.
+  void WaitFor(base::RepeatingCallback<bool()> condition) {
+    while (!condition.Run()) {
+      base::RunLoop run_loop;
+      quit_closure_ = run_loop.QuitClosure();
+      run_loop.Run();
+    }
+  }
+
+  base::WeakPtr<TestDelegate> GetWeakPtr() {
+    return weak_ptr_factory_.GetWeakPtr();
+  }
+
+  bool ready() const { return ready_; }
+  bool closed() const { return closed_; }
+  const std::vector<int>& progress() const { return progress_; }
+  const std::string& summary() const { return summary_; }
+  const std::vector<std::string>& circuits() const { return circuits_; }
+
+ private:
+  // TorControl::Delegate:
+  void OnTorControlReady() override {
+    ready_ = true;
+    Notify();
+  }
+  void OnTorControlClosed() override {
+    closed_ = true;
+    Notify();
+  }
+  void OnTorBootstrapProgress(int progress,
+                              const std::string& summary) override {
+    progress_.push_back(progress);
+    summary_ = summary;
+    Notify();
+  }
+  void OnTorCircuitEvent(const std::string& circuit_id,
+                         const std::string& status) override {
+    circuits_.push_back(circuit_id + " " + status);
+    Notify();
+  }
+
+  void Notify() {
+    if (quit_closure_)
+      std::move(quit_closure_).Run();
+  }
+
+  bool ready_ = false;
+  bool closed_ = false;
+  std::vector<int> progress_;
+  std::string summary_;
+  std::vector<std::string> circuits_;
+  base::OnceClosure quit_closure_;
+
+  base::WeakPtrFactory<TestDelegate> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(TestDelegate);
+};
+
+}  // namespace
+
+class TorControlTest : public testing::Test {
+ public:
+  TorControlTest()
+      : task_environment_(base::test::TaskEnvironment::MainThreadType::IO) {}
+  ~TorControlTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(server_.Start());
+    control_ = std::make_unique<TorControl>(
+        delegate_.GetWeakPtr(), base::ThreadTaskRunnerHandle::Get());
+  }
+
+  void TearDown() override { control_.reset(); }
+
+  void WaitForReady() {
+    delegate_.WaitFor(base::BindRepeating(
+        [](TestDelegate* delegate) {
+          return delegate->ready() && !delegate->progress().empty();
+        },
+        &delegate_));
+  }
+
+  void WaitForClosed() {
+    delegate_.WaitFor(base::BindRepeating(&TestDelegate::closed,
+                                          base::Unretained(&delegate_)));
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  FakeTorControlServer server_;
+  TestDelegate delegate_;
+  std::unique_ptr<TorControl> control_;
+};
+
+TEST_F(TorControlTest, ReportsBootstrapProgressAndCircuits) {
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), GetCookie()));
+  control_->Start(temp_dir_.GetPath());
+  WaitForReady();
+
+  const std::string cookie = GetCookie();
+  ASSERT_EQ(3u, server_.commands().size());
+  EXPECT_EQ("AUTHENTICATE " + base::HexEncode(cookie.data(), cookie.size()),
+            server_.commands()[0]);
+  EXPECT_EQ("SETEVENTS STATUS_CLIENT CIRC", server_.commands()[1]);
+  EXPECT_EQ("GETINFO status/bootstrap-phase", server_.commands()[2]);
+  EXPECT_EQ(std::vector<int>({0}), delegate_.progress());
+  EXPECT_EQ("Starting", delegate_.summary());
+
+  server_.SendLine(
+      "650 STATUS_CLIENT NOTICE BOOTSTRAP PROGRESS=50 "
+      "TAG=loading_descriptors SUMMARY=\"Loading relay descriptors\"");
+  server_.SendLine("650 CIRC 1 LAUNCHED BUILD_FLAGS=NEED_CAPACITY");
+  server_.SendLine(
+      "650 STATUS_CLIENT NOTICE BOOTSTRAP PROGRESS=100 TAG=done "
+      "SUMMARY=\"Done\"");
+  server_.SendLine("650 CIRC 1 BUILT $AAAA~relay1,$BBBB~relay2");
+  delegate_.WaitFor(base::BindRepeating(
+      [](TestDelegate* delegate) { return delegate->circuits().size() == 2; },
+      &delegate_));
+
+  EXPECT_EQ(std::vector<int>({0, 50, 100}), delegate_.progress());
+  EXPECT_EQ("Done", delegate_.summary());
+  EXPECT_EQ(std::vector<std::string>({"1 LAUNCHED", "1 BUILT"}),
+            delegate_.circuits());
+  EXPECT_FALSE(delegate_.closed());
+}
+
+TEST_F(TorControlTest, IgnoresOtherStatusEvents) {
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), GetCookie()));
+  control_->Start(temp_dir_.GetPath());
+  WaitForReady();
+
+  server_.SendLine("650 STATUS_CLIENT NOTICE CIRCUIT_ESTABLISHED");
+  server_.SendLine("650-STATUS_CLIENT NOTICE BOOTSTRAP PROGRESS=10");
+  server_.SendLine("650 CIRC 2 BUILT");
+  delegate_.WaitFor(base::BindRepeating(
+      [](TestDelegate* delegate) { return !delegate->circuits().empty(); },
+      &delegate_));
+
+  EXPECT_EQ(std::vector<int>({0}), delegate_.progress());
+}
+
+TEST_F(TorControlTest, WaitsForControlFiles) {
+  control_->Start(temp_dir_.GetPath());
+  // Tor hasn't written the files yet.
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(delegate_.ready());
+  EXPECT_FALSE(delegate_.closed());
+
+  server_.set_bootstrap_phase(
+      "NOTICE BOOTSTRAP PROGRESS=5 TAG=conn SUMMARY=\"Connecting to a relay\"");
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), GetCookie()));
+  WaitForReady();
+  EXPECT_EQ(std::vector<int>({5}), delegate_.progress());
+  EXPECT_EQ("Connecting to a relay", delegate_.summary());
+}
+
+TEST_F(TorControlTest, ClosesOnAuthenticationFailure) {
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), "wrong cookie"));
+  control_->Start(temp_dir_.GetPath());
+  WaitForClosed();
+
+  EXPECT_FALSE(delegate_.ready());
+  EXPECT_TRUE(delegate_.progress().empty());
+}
+
+TEST_F(TorControlTest, ClosesWhenTorCloses) {
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), GetCookie()));
+  control_->Start(temp_dir_.GetPath());
+  WaitForReady();
+
+  server_.CloseConnection();
+  WaitForClosed();
+}
+
+TEST_F(TorControlTest, StopDoesNotNotify) {
+  ASSERT_TRUE(server_.WriteControlFiles(temp_dir_.GetPath(), GetCookie()));
+  control_->Start(temp_dir_.GetPath());
+  WaitForReady();
+
+  control_->Stop();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(delegate_.closed());
+}
+
+}  // namespace tor
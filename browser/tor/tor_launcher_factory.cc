@@ -5,7 +5,10 @@
 
 #include "brave/browser/tor/tor_launcher_factory.h"
 
+#include "base/bind.h"
+#include "base/task/post_task.h"
 #include "brave/browser/tor/tor_profile_service_impl.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/service_manager_connection.h"
 #include "services/service_manager/public/cpp/connector.h"
@@ -14,6 +17,10 @@ using content::BrowserThread;
 
 namespace {
 bool g_prevent_tor_launch_for_tests = false;
+
+constexpr char kCircuitBuilt[] = "BUILT";
+constexpr char kCircuitFailed[] = "FAILED";
+constexpr char kCircuitClosed[] = "CLOSED";
 }
 
 // static
@@ -23,7 +30,8 @@ TorLauncherFactory* TorLauncherFactory::GetInstance() {
 
 TorLauncherFactory::TorLauncherFactory()
     : is_starting_(false),
-      tor_pid_(-1) {
+      tor_pid_(-1),
+      bootstrap_progress_(-1) {
   if (g_prevent_tor_launch_for_tests) {
     tor_pid_ = 1234;
     VLOG(1) << "Skipping the tor process launch in tests.";
@@ -114,6 +122,7 @@ void TorLauncherFactory::ReLaunchTorProcess(const tor::TorConfig& config) {
 }
 
 void TorLauncherFactory::KillTorProcess() {
+  StopTorControl();
   tor_launcher_.reset();
   tor_pid_ = -1;
 }
@@ -129,6 +138,7 @@ void TorLauncherFactory::RemoveObserver(tor::TorProfileServiceImpl* service) {
 void TorLauncherFactory::OnTorLauncherCrashed() {
   LOG(ERROR) << "Tor Launcher Crashed";
   is_starting_ = false;
+  StopTorControl();
   for (auto& observer : observers_)
     observer.NotifyTorLauncherCrashed();
 }
@@ -136,6 +146,7 @@ void TorLauncherFactory::OnTorLauncherCrashed() {
 void TorLauncherFactory::OnTorCrashed(int64_t pid) {
   LOG(ERROR) << "Tor Process(" << pid << ") Crashed";
   is_starting_ = false;
+  StopTorControl();
   for (auto& observer : observers_)
     observer.NotifyTorCrashed(pid);
 }
@@ -144,6 +155,7 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
   if (result) {
     is_starting_ = false;
     tor_pid_ = pid;
+    StartTorControl();
   } else {
     LOG(ERROR) << "Tor Launching Failed(" << pid <<")";
   }
@@ -151,6 +163,74 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
     observer.NotifyTorLaunched(result, pid);
 }
 
+void TorLauncherFactory::StartTorControl() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  StopTorControl();
+  if (config_.tor_watch_path().empty())
+    return;
+
+  // Tor has just been launched, so it starts bootstrapping from scratch.
+  bootstrap_progress_ = 0;
+  tor_control_.reset(new tor::TorControl(
+      weak_ptr_factory_.GetWeakPtr(),
+      base::CreateSingleThreadTaskRunner({BrowserThread::UI})));
+  base::PostTask(FROM_HERE, {BrowserThread::IO},
+                 base::BindOnce(&tor::TorControl::Start,
+                                base::Unretained(tor_control_.get()),
+                                config_.tor_watch_path()));
+}
+
+void TorLauncherFactory::StopTorControl() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Drops the notifications the control has already posted.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  tor_control_.reset();
+  bootstrap_progress_ = -1;
+  built_circuits_.clear();
+}
+
+void TorLauncherFactory::OnTorControlReady() {
+  VLOG(1) << "Tor control is ready";
+}
+
+void TorLauncherFactory::OnTorControlClosed() {
+  LOG(WARNING) << "Tor control is closed";
+  tor_control_.reset();
+  if (IsTorConnected())
+    return;
+  // Nothing reports the progress anymore, so don't let anybody wait for it.
+  bootstrap_progress_ = -1;
+  for (auto& observer : observers_)
+    observer.NotifyTorBootstrapProgress(bootstrap_progress_, std::string());
+}
+
+void TorLauncherFactory::OnTorBootstrapProgress(int progress,
+                                                const std::string& summary) {
+  const bool was_connected = IsTorConnected();
+  bootstrap_progress_ = progress;
+  for (auto& observer : observers_)
+    observer.NotifyTorBootstrapProgress(progress, summary);
+  if (!was_connected && IsTorConnected()) {
+    for (auto& observer : observers_)
+      observer.NotifyTorConnected();
+  }
+}
+
+void TorLauncherFactory::OnTorCircuitEvent(const std::string& circuit_id,
+                                           const std::string& status) {
+  const bool was_established = !built_circuits_.empty();
+  if (status == kCircuitBuilt)
+    built_circuits_.insert(circuit_id);
+  else if (status == kCircuitFailed || status == kCircuitClosed)
+    built_circuits_.erase(circuit_id);
+
+  const bool established = !built_circuits_.empty();
+  if (established == was_established)
+    return;
+  for (auto& observer : observers_)
+    observer.NotifyTorCircuitEstablished(established);
+}
+
 ScopedTorLaunchPreventerForTest::ScopedTorLaunchPreventerForTest() {
   g_prevent_tor_launch_for_tests = true;
 }
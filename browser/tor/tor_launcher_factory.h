@@ -6,19 +6,24 @@
 #ifndef BRAVE_BROWSER_TOR_TOR_LAUNCHER_FACTORY_H_
 #define BRAVE_BROWSER_TOR_TOR_LAUNCHER_FACTORY_H_
 
+#include <memory>
+#include <set>
 #include <string>
 
 #include "base/memory/singleton.h"
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
+#include "brave/browser/tor/tor_control.h"
 #include "brave/common/tor/tor_common.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
+#include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/remote.h"
 
 namespace tor {
 class TorProfileServiceImpl;
 }
 
-class TorLauncherFactory {
+class TorLauncherFactory : public tor::TorControl::Delegate {
  public:
   static TorLauncherFactory* GetInstance();
 
@@ -28,6 +33,9 @@ class TorLauncherFactory {
   void KillTorProcess();
   const tor::TorConfig& GetTorConfig() const { return config_; }
   int64_t GetTorPid() const { return tor_pid_; }
+  // Bootstrap progress reported by the control port, -1 when it is unknown.
+  int GetTorBootstrapProgress() const { return bootstrap_progress_; }
+  bool IsTorConnected() const { return bootstrap_progress_ >= 100; }
 
   void AddObserver(tor::TorProfileServiceImpl* serice);
   void RemoveObserver(tor::TorProfileServiceImpl* service);
@@ -36,7 +44,7 @@ class TorLauncherFactory {
   friend struct base::DefaultSingletonTraits<TorLauncherFactory>;
 
   TorLauncherFactory();
-  ~TorLauncherFactory();
+  ~TorLauncherFactory() override;
 
   bool SetConfig(const tor::TorConfig& config);
 
@@ -44,6 +52,17 @@ class TorLauncherFactory {
   void OnTorCrashed(int64_t pid);
   void OnTorLaunched(bool result, int64_t pid);
 
+  void StartTorControl();
+  void StopTorControl();
+
+  // tor::TorControl::Delegate:
+  void OnTorControlReady() override;
+  void OnTorControlClosed() override;
+  void OnTorBootstrapProgress(int progress,
+                              const std::string& summary) override;
+  void OnTorCircuitEvent(const std::string& circuit_id,
+                         const std::string& status) override;
+
   bool is_starting_;
 
   mojo::Remote<tor::mojom::TorLauncher> tor_launcher_;
@@ -52,8 +71,16 @@ class TorLauncherFactory {
 
   tor::TorConfig config_;
 
+  // Lives on the IO thread.
+  std::unique_ptr<tor::TorControl, content::BrowserThread::DeleteOnIOThread>
+      tor_control_;
+  int bootstrap_progress_;
+  std::set<std::string> built_circuits_;
+
   base::ObserverList<tor::TorProfileServiceImpl> observers_;
 
+  base::WeakPtrFactory<TorLauncherFactory> weak_ptr_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(TorLauncherFactory);
 };
 
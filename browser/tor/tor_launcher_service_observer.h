@@ -6,6 +6,10 @@
 #ifndef BRAVE_BROWSER_TOR_TOR_LAUNCHER_SERVICE_OBSERVER_H_
 #define BRAVE_BROWSER_TOR_TOR_LAUNCHER_SERVICE_OBSERVER_H_
 
+#include <string>
+
+#include "base/observer_list_types.h"
+
 namespace tor {
 
 class TorLauncherServiceObserver : public base::CheckedObserver {
@@ -15,6 +19,12 @@ class TorLauncherServiceObserver : public base::CheckedObserver {
   virtual void OnTorLauncherCrashed() {}
   virtual void OnTorCrashed(int64_t pid) {}
   virtual void OnTorLaunched(bool result, int64_t pid) {}
+  virtual void OnTorBootstrapProgress(int progress,
+                                      const std::string& summary) {}
+  // Tor has finished bootstrapping and can carry traffic.
+  virtual void OnTorConnected() {}
+  // |established| is false when the last built circuit went away.
+  virtual void OnTorCircuitEstablished(bool established) {}
 };
 
 }  // namespace tor
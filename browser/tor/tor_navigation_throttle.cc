@@ -5,7 +5,10 @@
 
 #include "brave/browser/tor/tor_navigation_throttle.h"
 
+#include "base/bind.h"
 #include "brave/browser/profiles/profile_util.h"
+#include "brave/browser/tor/tor_profile_service.h"
+#include "brave/browser/tor/tor_profile_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/web_contents.h"
@@ -22,20 +25,35 @@ TorNavigationThrottle::MaybeCreateThrottleFor(
       navigation_handle->GetWebContents()->GetBrowserContext());
   if (!brave::IsTorProfile(profile))
     return nullptr;
-  return std::make_unique<TorNavigationThrottle>(navigation_handle);
+  return std::make_unique<TorNavigationThrottle>(
+      navigation_handle, TorProfileServiceFactory::GetForProfile(profile));
 }
 
 TorNavigationThrottle::TorNavigationThrottle(
-    content::NavigationHandle* navigation_handle)
-    : content::NavigationThrottle(navigation_handle) {}
+    content::NavigationHandle* navigation_handle,
+    TorProfileService* service)
+    : content::NavigationThrottle(navigation_handle), service_(service) {}
 
-TorNavigationThrottle::~TorNavigationThrottle() = default;
+TorNavigationThrottle::~TorNavigationThrottle() {
+  if (deferred_)
+    service_->RemoveObserver(this);
+}
 
 content::NavigationThrottle::ThrottleCheckResult
 TorNavigationThrottle::WillStartRequest() {
   GURL url = navigation_handle()->GetURL();
-  if (url.SchemeIsHTTPOrHTTPS() ||
-      url.SchemeIs(content::kChromeUIScheme) ||
+  if (url.SchemeIsHTTPOrHTTPS()) {
+    if (!IsTorBootstrapping())
+      return content::NavigationThrottle::PROCEED;
+    deferred_ = true;
+    service_->AddObserver(this);
+    bootstrap_timer_.Start(
+        FROM_HERE, base::TimeDelta::FromSeconds(kBootstrapTimeoutSeconds),
+        base::BindOnce(&TorNavigationThrottle::ResumeIfDeferred,
+                       base::Unretained(this)));
+    return content::NavigationThrottle::DEFER;
+  }
+  if (url.SchemeIs(content::kChromeUIScheme) ||
       url.SchemeIs(extensions::kExtensionScheme) ||
       url.SchemeIs(content::kChromeDevToolsScheme))
     return content::NavigationThrottle::PROCEED;
@@ -46,4 +64,38 @@ const char* TorNavigationThrottle::GetNameForLogging() {
   return "TorNavigationThrottle";
 }
 
+void TorNavigationThrottle::OnTorLauncherCrashed() {
+  ResumeIfDeferred();
+}
+
+void TorNavigationThrottle::OnTorCrashed(int64_t pid) {
+  ResumeIfDeferred();
+}
+
+void TorNavigationThrottle::OnTorBootstrapProgress(
+    int progress,
+    const std::string& summary) {
+  if (!IsTorBootstrapping())
+    ResumeIfDeferred();
+}
+
+bool TorNavigationThrottle::IsTorBootstrapping() const {
+  // Unknown progress means nothing reports it, so there is nothing to wait
+  // for and the proxy reports the errors.
+  if (!service_)
+    return false;
+  const int progress = service_->GetTorBootstrapProgress();
+  return progress >= 0 && progress < 100;
+}
+
+void TorNavigationThrottle::ResumeIfDeferred() {
+  if (!deferred_)
+    return;
+  deferred_ = false;
+  bootstrap_timer_.Stop();
+  service_->RemoveObserver(this);
+  // May delete |this|.
+  Resume();
+}
+
 }  // namespace tor
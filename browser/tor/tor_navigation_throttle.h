@@ -7,7 +7,10 @@
 #define BRAVE_BROWSER_TOR_TOR_NAVIGATION_THROTTLE_H_
 
 #include <memory>
+#include <string>
 
+#include "base/timer/timer.h"
+#include "brave/browser/tor/tor_launcher_service_observer.h"
 #include "content/public/browser/navigation_throttle.h"
 
 namespace content {
@@ -16,11 +19,22 @@ class NavigationHandle;
 
 namespace tor {
 
-class TorNavigationThrottle : public content::NavigationThrottle {
+class TorProfileService;
+
+// Blocks the schemes tor can't carry and holds web requests back while tor is
+// still bootstrapping, so they start as soon as it can carry them.
+class TorNavigationThrottle : public content::NavigationThrottle,
+                              public TorLauncherServiceObserver {
  public:
+  // Longest time a request is held back, then the proxy reports the errors if
+  // tor is still not done.
+  static constexpr int kBootstrapTimeoutSeconds = 30;
+
   static std::unique_ptr<TorNavigationThrottle>
     MaybeCreateThrottleFor(content::NavigationHandle* navigation_handle);
-  explicit TorNavigationThrottle(content::NavigationHandle* navigation_handle);
+  // |service| may be null, then requests are never deferred.
+  TorNavigationThrottle(content::NavigationHandle* navigation_handle,
+                        TorProfileService* service);
   ~TorNavigationThrottle() override;
 
   // content::NavigationThrottle implementation:
@@ -28,6 +42,19 @@ class TorNavigationThrottle : public content::NavigationThrottle {
   const char* GetNameForLogging() override;
 
  private:
+  // TorLauncherServiceObserver:
+  void OnTorLauncherCrashed() override;
+  void OnTorCrashed(int64_t pid) override;
+  void OnTorBootstrapProgress(int progress,
+                              const std::string& summary) override;
+
+  bool IsTorBootstrapping() const;
+  void ResumeIfDeferred();
+
+  TorProfileService* service_;  // NOT OWNED
+  bool deferred_ = false;
+  base::OneShotTimer bootstrap_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(TorNavigationThrottle);
 };
 
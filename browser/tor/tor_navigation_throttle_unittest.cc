@@ -5,12 +5,17 @@
 
 #include "brave/browser/tor/tor_navigation_throttle.h"
 
+#include <memory>
+#include <string>
 #include <utility>
 
 #include "base/files/scoped_temp_dir.h"
+#include "base/test/bind_test_util.h"
 #include "brave/browser/profiles/brave_profile_manager.h"
 #include "brave/browser/profiles/profile_util.h"
 #include "brave/browser/profiles/tor_unittest_profile_manager.h"
+#include "brave/browser/tor/tor_launcher_service_observer.h"
+#include "brave/browser/tor/tor_profile_service.h"
 #include "chrome/test/base/scoped_testing_local_state.h"
 #include "chrome/test/base/testing_browser_process.h"
 #include "chrome/test/base/testing_profile.h"
@@ -18,6 +23,7 @@
 #include "content/public/test/mock_navigation_handle.h"
 #include "content/public/test/browser_task_environment.h"
 #include "content/public/test/web_contents_tester.h"
+#include "net/proxy_resolution/proxy_config_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -25,6 +31,45 @@ using content::NavigationThrottle;
 
 namespace tor {
 
+namespace {
+
+// Reports the bootstrap progress the test sets, the way TorLauncherFactory
+// reports the progress it reads from the control port.
+class FakeTorProfileService : public TorProfileService {
+ public:
+  FakeTorProfileService() = default;
+  ~FakeTorProfileService() override = default;
+
+  void SetNewTorCircuit(content::WebContents* web_contents) override {}
+  std::unique_ptr<net::ProxyConfigService> CreateProxyConfigService()
+      override {
+    return nullptr;
+  }
+  bool IsTorConnected() override { return progress_ == 100; }
+  int GetTorBootstrapProgress() override { return progress_; }
+
+  void SetBootstrapProgress(int progress) {
+    progress_ = progress;
+    for (auto& observer : observers_)
+      observer.OnTorBootstrapProgress(progress, std::string());
+  }
+
+  // The launcher reports unknown progress once the control port closes.
+  void CloseControl() { SetBootstrapProgress(-1); }
+
+  void Crash() {
+    for (auto& observer : observers_)
+      observer.OnTorCrashed(1234);
+  }
+
+ private:
+  int progress_ = -1;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeTorProfileService);
+};
+
+}  // namespace
+
 class TorNavigationThrottleUnitTest : public testing::Test {
  public:
   TorNavigationThrottleUnitTest()
@@ -64,8 +109,26 @@ class TorNavigationThrottleUnitTest : public testing::Test {
     return tor_web_contents_.get();
   }
 
+  content::BrowserTaskEnvironment* task_environment() {
+    return &task_environment_;
+  }
+
+  // Creates a throttle for an http request in the tor window which reports
+  // when it is resumed.
+  std::unique_ptr<TorNavigationThrottle> CreateThrottle(
+      content::MockNavigationHandle* handle,
+      FakeTorProfileService* service,
+      bool* resumed) {
+    handle->set_url(GURL("https://www.example.com"));
+    auto throttle = std::make_unique<TorNavigationThrottle>(handle, service);
+    throttle->set_resume_callback_for_testing(
+        base::BindLambdaForTesting([resumed]() { *resumed = true; }));
+    return throttle;
+  }
+
  private:
-  content::BrowserTaskEnvironment task_environment_;
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
   // The path to temporary directory used to contain the test operations.
   base::ScopedTempDir temp_dir_;
   ScopedTestingLocalState local_state_;
@@ -140,4 +203,81 @@ TEST_F(TorNavigationThrottleUnitTest, BlockedScheme) {
             throttle->WillStartRequest().action()) << url3;
 }
 
+TEST_F(TorNavigationThrottleUnitTest, ProceedsWhenProgressIsUnknownOrDone) {
+  FakeTorProfileService service;
+  content::MockNavigationHandle test_handle(tor_web_contents());
+  bool resumed = false;
+  std::unique_ptr<TorNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::PROCEED, throttle->WillStartRequest().action());
+
+  service.SetBootstrapProgress(100);
+  EXPECT_EQ(NavigationThrottle::PROCEED, throttle->WillStartRequest().action());
+  EXPECT_FALSE(resumed);
+}
+
+TEST_F(TorNavigationThrottleUnitTest, ResumesWhenBootstrapped) {
+  FakeTorProfileService service;
+  service.SetBootstrapProgress(10);
+  content::MockNavigationHandle test_handle(tor_web_contents());
+  bool resumed = false;
+  std::unique_ptr<TorNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+
+  service.SetBootstrapProgress(50);
+  EXPECT_FALSE(resumed);
+
+  service.SetBootstrapProgress(100);
+  EXPECT_TRUE(resumed);
+}
+
+TEST_F(TorNavigationThrottleUnitTest, ResumesWhenTorCrashes) {
+  FakeTorProfileService service;
+  service.SetBootstrapProgress(10);
+  content::MockNavigationHandle test_handle(tor_web_contents());
+  bool resumed = false;
+  std::unique_ptr<TorNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+
+  service.Crash();
+  EXPECT_TRUE(resumed);
+}
+
+TEST_F(TorNavigationThrottleUnitTest, ResumesWhenControlCloses) {
+  FakeTorProfileService service;
+  service.SetBootstrapProgress(10);
+  content::MockNavigationHandle test_handle(tor_web_contents());
+  bool resumed = false;
+  std::unique_ptr<TorNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+
+  service.CloseControl();
+  EXPECT_TRUE(resumed);
+}
+
+TEST_F(TorNavigationThrottleUnitTest, ResumesWhenBootstrapStalls) {
+  FakeTorProfileService service;
+  service.SetBootstrapProgress(10);
+  content::MockNavigationHandle test_handle(tor_web_contents());
+  bool resumed = false;
+  std::unique_ptr<TorNavigationThrottle> throttle =
+      CreateThrottle(&test_handle, &service, &resumed);
+  EXPECT_EQ(NavigationThrottle::DEFER, throttle->WillStartRequest().action());
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(
+      TorNavigationThrottle::kBootstrapTimeoutSeconds - 1));
+  EXPECT_FALSE(resumed);
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(resumed);
+
+  // Progress after the timeout doesn't resume the request again.
+  resumed = false;
+  service.SetBootstrapProgress(100);
+  EXPECT_FALSE(resumed);
+}
+
 }  // namespace tor
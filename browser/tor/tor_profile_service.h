@@ -46,6 +46,10 @@ class TorProfileService : public KeyedService {
   virtual void SetNewTorCircuit(content::WebContents* web_contents) = 0;
   virtual std::unique_ptr<net::ProxyConfigService>
       CreateProxyConfigService() = 0;
+  // Whether tor has finished bootstrapping and can carry traffic.
+  virtual bool IsTorConnected() = 0;
+  // Bootstrap progress in percents, or -1 when it is not known yet.
+  virtual int GetTorBootstrapProgress() = 0;
   void AddObserver(TorLauncherServiceObserver* observer);
   void RemoveObserver(TorLauncherServiceObserver* observer);
 
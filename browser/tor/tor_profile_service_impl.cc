@@ -201,6 +201,33 @@ void TorProfileServiceImpl::NotifyTorLaunched(bool result, int64_t pid) {
     observer.OnTorLaunched(result, pid);
 }
 
+void TorProfileServiceImpl::NotifyTorBootstrapProgress(
+    int progress,
+    const std::string& summary) {
+  for (auto& observer : observers_)
+    observer.OnTorBootstrapProgress(progress, summary);
+}
+
+void TorProfileServiceImpl::NotifyTorConnected() {
+  for (auto& observer : observers_)
+    observer.OnTorConnected();
+}
+
+void TorProfileServiceImpl::NotifyTorCircuitEstablished(bool established) {
+  for (auto& observer : observers_)
+    observer.OnTorCircuitEstablished(established);
+}
+
+bool TorProfileServiceImpl::IsTorConnected() {
+  return tor_launcher_factory_ && tor_launcher_factory_->IsTorConnected();
+}
+
+int TorProfileServiceImpl::GetTorBootstrapProgress() {
+  if (!tor_launcher_factory_)
+    return -1;
+  return tor_launcher_factory_->GetTorBootstrapProgress();
+}
+
 std::unique_ptr<net::ProxyConfigService>
 TorProfileServiceImpl::CreateProxyConfigService() {
   proxy_config_service_ = new net::ProxyConfigServiceTor(GetTorProxyURI());
@@ -7,6 +7,7 @@
 #define BRAVE_BROWSER_TOR_TOR_PROFILE_SERVICE_IMPL_H_
 
 #include <memory>
+#include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "base/optional.h"
@@ -38,6 +39,8 @@ class TorProfileServiceImpl : public TorProfileService,
   // TorProfileService:
   void SetNewTorCircuit(content::WebContents* web_contents) override;
   std::unique_ptr<net::ProxyConfigService> CreateProxyConfigService() override;
+  bool IsTorConnected() override;
+  int GetTorBootstrapProgress() override;
 
   void KillTor();
 
@@ -45,6 +48,9 @@ class TorProfileServiceImpl : public TorProfileService,
   void NotifyTorLauncherCrashed();
   void NotifyTorCrashed(int64_t pid);
   void NotifyTorLaunched(bool result, int64_t pid);
+  void NotifyTorBootstrapProgress(int progress, const std::string& summary);
+  void NotifyTorConnected();
+  void NotifyTorCircuitEstablished(bool established);
 
  private:
   void LaunchTor();
@@ -13,6 +13,8 @@
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
@@ -83,9 +85,10 @@ bool BraveOmniboxClientImpl::IsAutocompleteEnabled() const {
 
 void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
   if (IsSearchEvent(match)) {
-    // TODO(iefremov): Optimize this.
-    WeeklyStorage storage(profile_->GetPrefs(), kSearchCountPrefName);
-    storage.AddDelta(1);
-    RecordSearchEventP3A(storage.GetWeeklySum());
+    WeeklyStorage* storage =
+        WeeklyStorageRegistryFactory::GetForBrowserContext(profile_)->Get(
+            kSearchCountPrefName);
+    storage->AddDelta(1);
+    RecordSearchEventP3A(storage->GetWeeklySum());
   }
 }
@@ -9,5 +9,8 @@
 namespace tor {
 
 const base::FilePath::CharType kTorProfileDir[] = FPL("Tor Profile");
+const base::FilePath::CharType kTorControlPortFile[] = FPL("controlport");
+const base::FilePath::CharType kTorControlCookieFile[] =
+    FPL("control_auth_cookie");
 
 }  // namespace tor
@@ -12,6 +12,9 @@
 namespace tor {
 
 extern const base::FilePath::CharType kTorProfileDir[];
+// Files tor writes to the watch directory for its control port clients.
+extern const base::FilePath::CharType kTorControlPortFile[];
+extern const base::FilePath::CharType kTorControlCookieFile[];
 
 }  // namespace tor
 
@@ -8,8 +8,11 @@
 #include <memory>
 #include <utility>
 
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/page_text_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
@@ -18,8 +21,6 @@
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
 #include "ui/base/resource/resource_bundle.h"
-#include "third_party/re2/src/re2/re2.h"
-#include "base/strings/string_util.h"
 
 #if !defined(OS_ANDROID)
 #include "chrome/browser/ui/browser.h"
@@ -80,8 +81,9 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
       source_page_handle->web_contents()->GetMainFrame();
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(render_frame_host,
-      "document.body.innerText",
+  const std::string script = GetPageTextScript(GetPageTextMaxLength());
+
+  dom_distiller::RunIsolatedJavaScript(render_frame_host, script,
           base::BindOnce(&AdsTabHelper::OnWebContentsDistillationDone,
               weak_factory_.GetWeakPtr(),
                   source_page_handle->web_contents()->GetLastCommittedURL(),
@@ -97,13 +99,23 @@ void AdsTabHelper::OnWebContentsDistillationDone(
   }
 
   DCHECK(value.is_string());
-  std::string content;
-  value.GetAsString(&content);
 
-  RE2::GlobalReplace(&content, "[[:cntrl:]]|[[:space:]]|\\\\x[[:xdigit:]]"
-      "[[:xdigit:]]|\\\\(t|n|v|f|r)", " ");
+  // Normalizing the text of large pages is expensive so should not block the
+  // UI thread
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::BEST_EFFORT,
+          base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&NormalizePageText, std::move(value.GetString())),
+      base::BindOnce(&AdsTabHelper::OnPageTextNormalized,
+          weak_factory_.GetWeakPtr(), url));
+}
 
-  content = base::CollapseWhitespaceASCII(content, false);
+void AdsTabHelper::OnPageTextNormalized(
+    const GURL& url,
+    std::string content) {
+  if (!ads_service_) {
+    return;
+  }
 
   ads_service_->OnPageLoaded(url.spec(), content);
 }
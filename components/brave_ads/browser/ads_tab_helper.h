@@ -77,6 +77,9 @@ class AdsTabHelper : public content::WebContentsObserver,
       const GURL& url,
       const base::TimeTicks& javascript_start,
       base::Value value);
+  void OnPageTextNormalized(
+      const GURL& url,
+      std::string content);
 
   SessionID tab_id_;
   AdsService* ads_service_;  // NOT OWNED
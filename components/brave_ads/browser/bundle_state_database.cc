@@ -8,7 +8,9 @@
 #include <stdint.h>
 #include <limits>
 #include <map>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/bind.h"
@@ -25,11 +27,98 @@ namespace brave_ads {
 
 namespace {
 
-const int kCurrentVersionNumber = 5;
+const int kCurrentVersionNumber = 6;
 const int kCompatibleVersionNumber = 5;
 
+// The database is only vacuumed once at least this ratio of pages are free
+const double kVacuumFreePageRatioThreshold = 0.25;
+
+// Categories are resolved through the |eligible_category| temporary table so
+// that the statement can be cached and served using index lookups
+const char kGetCreativeAdNotificationsSql[] =
+    "SELECT "
+        "ai.creative_set_id, "
+        "ai.advertiser, "
+        "ai.notification_text, "
+        "ai.notification_url, "
+        "ai.start_timestamp, "
+        "ai.end_timestamp, "
+        "ai.uuid, "
+        "ai.region, "
+        "ai.campaign_id, "
+        "ai.daily_cap, "
+        "ai.advertiser_id, "
+        "ai.per_day, "
+        "ai.total_max, "
+        "aic.category_name "
+    "FROM temp.eligible_category AS ec "
+        "INNER JOIN ad_info_category AS aic "
+            "ON aic.category_name = ec.name "
+        "INNER JOIN ad_info AS ai "
+            "ON ai.uuid = aic.ad_info_uuid "
+    "WHERE ? BETWEEN ai.start_timestamp AND ai.end_timestamp";
+
+int64_t ParseStartTimestamp(
+    const std::string& timestamp) {
+  base::Time time;
+  if (!base::Time::FromUTCString(timestamp.c_str(), &time)) {
+    return std::numeric_limits<uint64_t>::min();
+  }
+
+  return time.ToDoubleT();
+}
+
+int64_t ParseEndTimestamp(
+    const std::string& timestamp) {
+  base::Time time;
+  if (!base::Time::FromUTCString(timestamp.c_str(), &time)) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+
+  return time.ToDoubleT();
+}
+
+using AdConversionKey =
+    std::tuple<std::string, std::string, std::string, unsigned int>;
+
+AdConversionKey GetAdConversionKey(
+    const ads::AdConversionInfo& info) {
+  return std::make_tuple(info.creative_set_id, info.type, info.url_pattern,
+      info.observation_window);
+}
+
 }  // namespace
 
+struct BundleStateDatabase::CreativeAdNotificationRow {
+  bool operator==(
+      const CreativeAdNotificationRow& rhs) const {
+    return std::tie(creative_set_id, advertiser, notification_text,
+        notification_url, start_timestamp, end_timestamp, campaign_id,
+        daily_cap, advertiser_id, per_day, total_max) ==
+            std::tie(rhs.creative_set_id, rhs.advertiser,
+                rhs.notification_text, rhs.notification_url,
+                rhs.start_timestamp, rhs.end_timestamp, rhs.campaign_id,
+                rhs.daily_cap, rhs.advertiser_id, rhs.per_day, rhs.total_max);
+  }
+
+  bool operator!=(
+      const CreativeAdNotificationRow& rhs) const {
+    return !(*this == rhs);
+  }
+
+  std::string creative_set_id;
+  std::string advertiser;
+  std::string notification_text;
+  std::string notification_url;
+  int64_t start_timestamp = 0;
+  int64_t end_timestamp = 0;
+  std::string campaign_id;
+  int64_t daily_cap = 0;
+  std::string advertiser_id;
+  int64_t per_day = 0;
+  int64_t total_max = 0;
+};
+
 BundleStateDatabase::BundleStateDatabase(
     const base::FilePath& db_path)
     : db_path_(db_path),
@@ -73,7 +162,9 @@ bool BundleStateDatabase::Init() {
       !CreateCreativeAdNotificationsTable() ||
       !CreateCreativeAdNotificationCategoriesTable() ||
       !CreateCreativeAdNotificationCategoriesCategoryIndex() ||
-      !CreateAdConversionsTable()) {
+      !CreateCreativeAdNotificationsUuidIndex() ||
+      !CreateAdConversionsTable() ||
+      !CreateEligibleCategoriesTable()) {
     return false;
   }
 
@@ -111,16 +202,30 @@ bool BundleStateDatabase::CreateCategoriesTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoriesTable() {
+bool BundleStateDatabase::GetCategories(
+    std::set<std::string>* categories) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  DCHECK(categories);
 
-  const std::string sql =
-      "DELETE FROM category";
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT name FROM category"));
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  while (statement.Step()) {
+    categories->insert(statement.ColumnString(0));
+  }
+
+  return statement.Succeeded();
+}
+
+bool BundleStateDatabase::DeleteCategory(
+    const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM category WHERE name = ?"));
+
+  statement.BindString(0, category);
 
   return statement.Run();
 }
@@ -129,15 +234,9 @@ bool BundleStateDatabase::InsertOrUpdateCategory(
     const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql = base::StringPrintf(
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "INSERT OR REPLACE INTO category "
-          "(name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(1).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+          "(name) VALUES (?)"));
 
   statement.BindString(0, category);
 
@@ -175,83 +274,100 @@ bool BundleStateDatabase::CreateCreativeAdNotificationsTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCreativeAdNotificationsTable() {
+bool BundleStateDatabase::GetCreativeAdNotificationRows(
+    CreativeAdNotificationRowMap* rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  DCHECK(rows);
 
-  const std::string sql =
-      "DELETE FROM ad_info";
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT "
+          "uuid, "
+          "region, "
+          "creative_set_id, "
+          "advertiser, "
+          "notification_text, "
+          "notification_url, "
+          "start_timestamp, "
+          "end_timestamp, "
+          "campaign_id, "
+          "daily_cap, "
+          "advertiser_id, "
+          "per_day, "
+          "total_max "
+      "FROM ad_info"));
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  while (statement.Step()) {
+    CreativeAdNotificationRow row;
+    row.creative_set_id = statement.ColumnString(2);
+    row.advertiser = statement.ColumnString(3);
+    row.notification_text = statement.ColumnString(4);
+    row.notification_url = statement.ColumnString(5);
+    row.start_timestamp = statement.ColumnInt64(6);
+    row.end_timestamp = statement.ColumnInt64(7);
+    row.campaign_id = statement.ColumnString(8);
+    row.daily_cap = statement.ColumnInt64(9);
+    row.advertiser_id = statement.ColumnString(10);
+    row.per_day = statement.ColumnInt64(11);
+    row.total_max = statement.ColumnInt64(12);
+
+    const CreativeAdNotificationRowKey key(statement.ColumnString(0),
+        statement.ColumnString(1));
+    rows->emplace(key, row);
+  }
 
-  return statement.Run();
+  return statement.Succeeded();
 }
 
-bool BundleStateDatabase::InsertOrUpdateCreativeAdNotification(
-    const ads::CreativeAdNotificationInfo& info) {
+bool BundleStateDatabase::DeleteCreativeAdNotification(
+    const CreativeAdNotificationRowKey& key) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info WHERE uuid = ? AND region = ?"));
 
-  for (const auto& geo_target : info.geo_targets) {
-    const std::string sql = base::StringPrintf(
-        "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, "
-            "advertiser, "
-            "notification_text, "
-            "notification_url, "
-            "start_timestamp, "
-            "end_timestamp, "
-            "uuid, "
-            "campaign_id, "
-            "daily_cap, "
-            "advertiser_id, "
-            "per_day, "
-            "total_max, "
-            "region) VALUES (%s)",
-      CreateBindingParameterPlaceholders(13).c_str());
-
-    sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-    statement.BindString(0, info.creative_set_id);
-    statement.BindString(1, info.title);
-    statement.BindString(2, info.body);
-    statement.BindString(3, info.target_url);
-
-    base::Time start_at_time;
-    if (base::Time::FromUTCString(info.start_at_timestamp.c_str(),
-        &start_at_time)) {
-      statement.BindInt64(4, start_at_time.ToDoubleT());
-    } else {
-      statement.BindInt64(4, std::numeric_limits<uint64_t>::min());
-    }
+  statement.BindString(0, key.first);
+  statement.BindString(1, key.second);
 
-    base::Time end_at_time;
-    if (base::Time::FromUTCString(info.end_at_timestamp.c_str(),
-        &end_at_time)) {
-      statement.BindInt64(5, end_at_time.ToDoubleT());
-    } else {
-      statement.BindInt64(5, std::numeric_limits<uint64_t>::max());
-    }
+  return statement.Run();
+}
 
-    statement.BindString(6, info.creative_instance_id);
-    statement.BindString(7, info.campaign_id);
-    // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
-    statement.BindInt64(8, info.daily_cap);
-    statement.BindString(9, info.advertiser_id);
-    statement.BindInt64(10, info.per_day);
-    statement.BindInt64(11, info.total_max);
-    statement.BindString(12, geo_target);
+bool BundleStateDatabase::InsertOrUpdateCreativeAdNotification(
+    const CreativeAdNotificationRowKey& key,
+    const CreativeAdNotificationRow& row) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-    if (!statement.Run()) {
-      return false;
-    }
-  }
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO ad_info "
+          "(creative_set_id, "
+          "advertiser, "
+          "notification_text, "
+          "notification_url, "
+          "start_timestamp, "
+          "end_timestamp, "
+          "uuid, "
+          "campaign_id, "
+          "daily_cap, "
+          "advertiser_id, "
+          "per_day, "
+          "total_max, "
+          "region) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
+
+  statement.BindString(0, row.creative_set_id);
+  statement.BindString(1, row.advertiser);
+  statement.BindString(2, row.notification_text);
+  statement.BindString(3, row.notification_url);
+  statement.BindInt64(4, row.start_timestamp);
+  statement.BindInt64(5, row.end_timestamp);
+  statement.BindString(6, key.first);
+  statement.BindString(7, row.campaign_id);
+  statement.BindInt64(8, row.daily_cap);
+  statement.BindString(9, row.advertiser_id);
+  statement.BindInt64(10, row.per_day);
+  statement.BindInt64(11, row.total_max);
+  statement.BindString(12, key.second);
 
-  return true;
+  return statement.Run();
 }
 
 bool BundleStateDatabase::CreateCreativeAdNotificationCategoriesTable() {
@@ -280,38 +396,47 @@ bool BundleStateDatabase::CreateCreativeAdNotificationCategoriesTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCreativeAdNotificationCategoriesTable() {
+bool BundleStateDatabase::GetCreativeAdNotificationCategories(
+    CreativeAdNotificationCategorySet* categories) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  DCHECK(categories);
 
-  const std::string sql =
-      "DELETE FROM ad_info_category";
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT ad_info_uuid, category_name FROM ad_info_category"));
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  while (statement.Step()) {
+    categories->emplace(statement.ColumnString(0), statement.ColumnString(1));
+  }
+
+  return statement.Succeeded();
+}
+
+bool BundleStateDatabase::DeleteCreativeAdNotificationCategory(
+    const CreativeAdNotificationCategoryKey& key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info_category "
+          "WHERE ad_info_uuid = ? AND category_name = ?"));
+
+  statement.BindString(0, key.first);
+  statement.BindString(1, key.second);
 
   return statement.Run();
 }
 
 bool BundleStateDatabase::InsertOrUpdateCreativeAdNotificationCategory(
-    const ads::CreativeAdNotificationInfo& info,
-    const std::string& category) {
+    const CreativeAdNotificationCategoryKey& key) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql = base::StringPrintf(
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "INSERT OR REPLACE INTO ad_info_category "
           "(ad_info_uuid, "
-          "category_name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(2).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+          "category_name) VALUES (?, ?)"));
 
-  statement.BindString(0, info.creative_instance_id);
-  statement.BindString(1, category);
+  statement.BindString(0, key.first);
+  statement.BindString(1, key.second);
 
   return statement.Run();
 }
@@ -327,6 +452,63 @@ BundleStateDatabase::CreateCreativeAdNotificationCategoriesCategoryIndex() {
   return GetDB().Execute(sql.c_str());
 }
 
+bool BundleStateDatabase::CreateCreativeAdNotificationsUuidIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Includes the timestamps so that ads outside of the time window can be
+  // excluded without reading the table
+  const std::string sql =
+      "CREATE INDEX IF NOT EXISTS ad_info_uuid_timestamp_index "
+          "ON ad_info (uuid, start_timestamp, end_timestamp)";
+
+  return GetDB().Execute(sql.c_str());
+}
+
+bool BundleStateDatabase::CreateEligibleCategoriesTable() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Temporary tables only live as long as the connection so are never written
+  // to the database file
+  const std::string sql =
+      "CREATE TEMP TABLE IF NOT EXISTS eligible_category "
+          "(name LONGVARCHAR PRIMARY KEY)";
+
+  return GetDB().Execute(sql.c_str());
+}
+
+bool BundleStateDatabase::UpdateEligibleCategories(
+    const std::vector<std::string>& categories) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // A failed insert rolls back to the previous categories, and all rows are
+  // committed at once
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM temp.eligible_category"));
+
+  if (!delete_statement.Run()) {
+    return false;
+  }
+
+  for (const auto& category : categories) {
+    sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "INSERT OR IGNORE INTO temp.eligible_category "
+            "(name) VALUES (?)"));
+
+    statement.BindString(0, category);
+
+    if (!statement.Run()) {
+      return false;
+    }
+  }
+
+  return transaction.Commit();
+}
+
 bool BundleStateDatabase::CreateAdConversionsTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -349,16 +531,41 @@ bool BundleStateDatabase::CreateAdConversionsTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdConversionsTable() {
+bool BundleStateDatabase::GetAdConversionRows(
+    AdConversionMap* ad_conversions) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  DCHECK(ad_conversions);
 
-  const std::string sql =
-      "DELETE FROM ad_conversions";
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT "
+          "id, "
+          "creative_set_id, "
+          "type, "
+          "url_pattern, "
+          "observation_window "
+      "FROM ad_conversions"));
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  while (statement.Step()) {
+    ads::AdConversionInfo info;
+    info.creative_set_id = statement.ColumnString(1);
+    info.type = statement.ColumnString(2);
+    info.url_pattern = statement.ColumnString(3);
+    info.observation_window = statement.ColumnInt(4);
+    ad_conversions->emplace(statement.ColumnInt64(0), info);
+  }
+
+  return statement.Succeeded();
+}
+
+bool BundleStateDatabase::DeleteAdConversion(
+    const int64_t id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_conversions WHERE id = ?"));
+
+  statement.BindInt64(0, id);
 
   return statement.Run();
 }
@@ -367,18 +574,12 @@ bool BundleStateDatabase::InsertOrUpdateAdConversion(
     const ads::AdConversionInfo& info) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql = base::StringPrintf(
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "INSERT OR REPLACE INTO ad_conversions "
           "(creative_set_id, "
           "type, "
           "url_pattern, "
-          "observation_window) VALUES (%s)",
-      CreateBindingParameterPlaceholders(4).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+          "observation_window) VALUES (?, ?, ?, ?)"));
 
   statement.BindString(0, info.creative_set_id);
   statement.BindString(1, info.type);
@@ -389,56 +590,214 @@ bool BundleStateDatabase::InsertOrUpdateAdConversion(
   return statement.Run();
 }
 
-bool BundleStateDatabase::SaveBundleState(
+bool BundleStateDatabase::UpdateCategories(
     const ads::BundleState& bundle_state) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  if (!GetDB().BeginTransaction()) {
+  std::set<std::string> categories;
+  if (!GetCategories(&categories)) {
     return false;
   }
 
-  // We are completely replacing the database here so truncate all the tables
-  if (!TruncateCategoriesTable() ||
-      !TruncateCreativeAdNotificationCategoriesTable() ||
-      !TruncateCreativeAdNotificationsTable() ||
-      !TruncateAdConversionsTable()) {
-    GetDB().RollbackTransaction();
-    return false;
+  for (const auto& category : categories) {
+    if (bundle_state.creative_ad_notifications.find(category) !=
+        bundle_state.creative_ad_notifications.end()) {
+      continue;
+    }
+
+    if (!DeleteCategory(category)) {
+      return false;
+    }
   }
 
   for (const auto& creative_ad_notification :
       bundle_state.creative_ad_notifications) {
     const std::string category = creative_ad_notification.first;
+    if (categories.find(category) != categories.end()) {
+      continue;
+    }
+
     if (!InsertOrUpdateCategory(category)) {
-      GetDB().RollbackTransaction();
       return false;
     }
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::UpdateCreativeAdNotifications(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-    const ads::CreativeAdNotificationList ads = creative_ad_notification.second;
-    for (const auto& ad : ads) {
-      if (!InsertOrUpdateCreativeAdNotification(ad) ||
-          !InsertOrUpdateCreativeAdNotificationCategory(ad, category)) {
-        GetDB().RollbackTransaction();
-        return false;
+  // Later entries replace earlier entries with the same key, matching the
+  // behavior of |INSERT OR REPLACE| when rebuilding the table from scratch
+  CreativeAdNotificationRowMap new_rows;
+  for (const auto& creative_ad_notification :
+      bundle_state.creative_ad_notifications) {
+    for (const auto& ad : creative_ad_notification.second) {
+      CreativeAdNotificationRow row;
+      row.creative_set_id = ad.creative_set_id;
+      row.advertiser = ad.title;
+      row.notification_text = ad.body;
+      row.notification_url = ad.target_url;
+      row.start_timestamp = ParseStartTimestamp(ad.start_at_timestamp);
+      row.end_timestamp = ParseEndTimestamp(ad.end_at_timestamp);
+      row.campaign_id = ad.campaign_id;
+      row.daily_cap = ad.daily_cap;
+      row.advertiser_id = ad.advertiser_id;
+      row.per_day = ad.per_day;
+      row.total_max = ad.total_max;
+
+      for (const auto& geo_target : ad.geo_targets) {
+        const CreativeAdNotificationRowKey key(ad.creative_instance_id,
+            geo_target);
+        new_rows[key] = row;
       }
     }
   }
 
+  CreativeAdNotificationRowMap rows;
+  if (!GetCreativeAdNotificationRows(&rows)) {
+    return false;
+  }
+
+  for (const auto& row : rows) {
+    if (new_rows.find(row.first) != new_rows.end()) {
+      continue;
+    }
+
+    if (!DeleteCreativeAdNotification(row.first)) {
+      return false;
+    }
+  }
+
+  for (const auto& new_row : new_rows) {
+    const auto iter = rows.find(new_row.first);
+    if (iter != rows.end() && iter->second == new_row.second) {
+      continue;
+    }
+
+    if (!InsertOrUpdateCreativeAdNotification(new_row.first,
+        new_row.second)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::UpdateCreativeAdNotificationCategories(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  CreativeAdNotificationCategorySet new_categories;
+  for (const auto& creative_ad_notification :
+      bundle_state.creative_ad_notifications) {
+    const std::string category = creative_ad_notification.first;
+    for (const auto& ad : creative_ad_notification.second) {
+      new_categories.emplace(ad.creative_instance_id, category);
+    }
+  }
+
+  CreativeAdNotificationCategorySet categories;
+  if (!GetCreativeAdNotificationCategories(&categories)) {
+    return false;
+  }
+
+  for (const auto& category : categories) {
+    if (new_categories.find(category) != new_categories.end()) {
+      continue;
+    }
+
+    if (!DeleteCreativeAdNotificationCategory(category)) {
+      return false;
+    }
+  }
+
+  for (const auto& new_category : new_categories) {
+    if (categories.find(new_category) != categories.end()) {
+      continue;
+    }
+
+    if (!InsertOrUpdateCreativeAdNotificationCategory(new_category)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::UpdateAdConversions(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Ad conversions have no natural key and may contain duplicates, so count
+  // the occurrences of each ad conversion in the new bundle state
+  std::map<AdConversionKey, size_t> new_ad_conversions;
+  for (const auto& ad_conversion : bundle_state.ad_conversions) {
+    new_ad_conversions[GetAdConversionKey(ad_conversion)]++;
+  }
+
+  AdConversionMap ad_conversions;
+  if (!GetAdConversionRows(&ad_conversions)) {
+    return false;
+  }
+
+  for (const auto& ad_conversion : ad_conversions) {
+    const auto iter =
+        new_ad_conversions.find(GetAdConversionKey(ad_conversion.second));
+    if (iter != new_ad_conversions.end() && iter->second > 0) {
+      iter->second--;
+      continue;
+    }
+
+    if (!DeleteAdConversion(ad_conversion.first)) {
+      return false;
+    }
+  }
+
   for (const auto& ad_conversion : bundle_state.ad_conversions) {
+    auto& count = new_ad_conversions[GetAdConversionKey(ad_conversion)];
+    if (count == 0) {
+      continue;
+    }
+
+    count--;
+
     if (!InsertOrUpdateAdConversion(ad_conversion)) {
-      GetDB().RollbackTransaction();
       return false;
     }
   }
 
+  return true;
+}
+
+bool BundleStateDatabase::SaveBundleState(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const bool is_initialized = Init();
+  DCHECK(is_initialized);
+
+  if (!GetDB().BeginTransaction()) {
+    return false;
+  }
+
+  // Only apply the rows which were added, changed or removed since the last
+  // catalog so that unchanged catalogs do not rewrite the database
+  if (!UpdateCreativeAdNotificationCategories(bundle_state) ||
+      !UpdateCreativeAdNotifications(bundle_state) ||
+      !UpdateCategories(bundle_state) ||
+      !UpdateAdConversions(bundle_state)) {
+    GetDB().RollbackTransaction();
+    return false;
+  }
+
   if (!GetDB().CommitTransaction()) {
     return false;
   }
 
-  Vacuum();
+  MaybeVacuum();
   return true;
 }
 
@@ -452,37 +811,15 @@ bool BundleStateDatabase::GetCreativeAdNotifications(
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  const std::string sql = base::StringPrintf(
-      "SELECT "
-          "ai.creative_set_id, "
-          "ai.advertiser, "
-          "ai.notification_text, "
-          "ai.notification_url, "
-          "ai.start_timestamp, "
-          "ai.end_timestamp, "
-          "ai.uuid, "
-          "ai.region, "
-          "ai.campaign_id, "
-          "ai.daily_cap, "
-          "ai.advertiser_id, "
-          "ai.per_day, "
-          "ai.total_max, "
-          "aic.category_name "
-      "FROM ad_info AS ai "
-          "INNER JOIN ad_info_category AS aic "
-              "ON aic.ad_info_uuid = ai.uuid "
-      "WHERE aic.category_name IN (%s) "
-          "AND CAST(strftime('%%s', 'now') AS TIMESTAMP) "
-              "BETWEEN ai.start_timestamp AND ai.end_timestamp",
-      CreateBindingParameterPlaceholders(categories.size()).c_str());
+  if (!UpdateEligibleCategories(categories)) {
+    return false;
+  }
 
-  sql::Statement statement(db_.GetUniqueStatement(sql.c_str()));
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      kGetCreativeAdNotificationsSql));
 
-  int index = 0;
-  for (const auto& category : categories) {
-    statement.BindString(index, category.c_str());
-    index++;
-  }
+  const int64_t now = base::Time::Now().ToDoubleT();
+  statement.BindInt64(0, now);
 
   while (statement.Step()) {
     ads::CreativeAdNotificationInfo info;
@@ -503,7 +840,29 @@ bool BundleStateDatabase::GetCreativeAdNotifications(
     ads->emplace_back(info);
   }
 
-  return true;
+  return statement.Succeeded();
+}
+
+bool BundleStateDatabase::GetCreativeAdNotificationsQueryPlanForTesting(
+    std::vector<std::string>* details) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  DCHECK(details);
+
+  const bool is_initialized = Init();
+  DCHECK(is_initialized);
+
+  const std::string sql = base::StringPrintf("EXPLAIN QUERY PLAN %s",
+      kGetCreativeAdNotificationsSql);
+
+  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+
+  // The last column of each row contains the human readable plan detail
+  while (statement.Step()) {
+    details->push_back(statement.ColumnString(statement.ColumnCount() - 1));
+  }
+
+  return statement.Succeeded();
 }
 
 bool BundleStateDatabase::GetAdConversions(
@@ -537,21 +896,6 @@ bool BundleStateDatabase::GetAdConversions(
   return true;
 }
 
-std::string BundleStateDatabase::CreateBindingParameterPlaceholders(
-    const size_t count) {
-  std::string placeholders;
-
-  for (size_t i = 0; i < count; i++) {
-    if (i != 0) {
-      placeholders += ", ";
-    }
-
-    placeholders += "?";
-  }
-
-  return placeholders;
-}
-
 // static
 int BundleStateDatabase::GetCurrentVersion() {
   return kCurrentVersionNumber;
@@ -569,6 +913,45 @@ void BundleStateDatabase::Vacuum() {
   ignore_result(db_.Execute("VACUUM"));
 }
 
+double BundleStateDatabase::GetFreePageRatio() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement page_count_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "PRAGMA page_count"));
+  if (!page_count_statement.Step()) {
+    return 0.0;
+  }
+
+  const int64_t page_count = page_count_statement.ColumnInt64(0);
+  if (page_count == 0) {
+    return 0.0;
+  }
+
+  sql::Statement freelist_count_statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE, "PRAGMA freelist_count"));
+  if (!freelist_count_statement.Step()) {
+    return 0.0;
+  }
+
+  const int64_t freelist_count = freelist_count_statement.ColumnInt64(0);
+
+  return static_cast<double>(freelist_count) / page_count;
+}
+
+void BundleStateDatabase::MaybeVacuum() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!is_initialized_) {
+    return;
+  }
+
+  if (GetFreePageRatio() < kVacuumFreePageRatioThreshold) {
+    return;
+  }
+
+  Vacuum();
+}
+
 void BundleStateDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -632,6 +1015,11 @@ bool BundleStateDatabase::Migrate() {
         break;
       }
 
+      case 5: {
+        success = MigrateV5toV6();
+        break;
+      }
+
       default: {
         NOTREACHED();
         break;
@@ -743,4 +1131,8 @@ bool BundleStateDatabase::MigrateV4toV5() {
   return GetDB().Execute(create_ad_info_table_sql.c_str());
 }
 
+bool BundleStateDatabase::MigrateV5toV6() {
+  return CreateCreativeAdNotificationsUuidIndex();
+}
+
 }  // namespace brave_ads
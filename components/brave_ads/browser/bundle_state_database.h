@@ -7,9 +7,13 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_STATE_DATABASE_H_
 
 #include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
-#include <memory>
 
 #include "bat/ads/creative_ad_notification_info.h"
 #include "bat/ads/ad_conversion_info.h"
@@ -52,6 +56,10 @@ class BundleStateDatabase {
   bool GetAdConversions(
       ads::AdConversionList* ad_conversions);
 
+  // Returns the query plan details used by |GetCreativeAdNotifications|
+  bool GetCreativeAdNotificationsQueryPlanForTesting(
+      std::vector<std::string>* details);
+
   // Returns the current version of the bundle state database
   static int GetCurrentVersion();
 
@@ -68,31 +76,78 @@ class BundleStateDatabase {
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
+  // Creative ad notification rows are keyed by |uuid| and |region| to match
+  // the primary key of the |ad_info| table
+  struct CreativeAdNotificationRow;
+  using CreativeAdNotificationRowKey = std::pair<std::string, std::string>;
+  using CreativeAdNotificationRowMap =
+      std::map<CreativeAdNotificationRowKey, CreativeAdNotificationRow>;
+
+  // Creative ad notification categories are keyed by |ad_info_uuid| and
+  // |category_name|
+  using CreativeAdNotificationCategoryKey =
+      std::pair<std::string, std::string>;
+  using CreativeAdNotificationCategorySet =
+      std::set<CreativeAdNotificationCategoryKey>;
+
+  using AdConversionMap = std::map<int64_t, ads::AdConversionInfo>;
+
   bool CreateCategoriesTable();
-  bool TruncateCategoriesTable();
+  bool GetCategories(
+      std::set<std::string>* categories);
+  bool DeleteCategory(
+      const std::string& category);
   bool InsertOrUpdateCategory(
       const std::string& category);
 
   bool CreateCreativeAdNotificationsTable();
-  bool TruncateCreativeAdNotificationsTable();
+  bool GetCreativeAdNotificationRows(
+      CreativeAdNotificationRowMap* rows);
+  bool DeleteCreativeAdNotification(
+      const CreativeAdNotificationRowKey& key);
   bool InsertOrUpdateCreativeAdNotification(
-      const ads::CreativeAdNotificationInfo& info);
+      const CreativeAdNotificationRowKey& key,
+      const CreativeAdNotificationRow& row);
 
   bool CreateCreativeAdNotificationCategoriesTable();
-  bool TruncateCreativeAdNotificationCategoriesTable();
+  bool GetCreativeAdNotificationCategories(
+      CreativeAdNotificationCategorySet* categories);
+  bool DeleteCreativeAdNotificationCategory(
+      const CreativeAdNotificationCategoryKey& key);
   bool InsertOrUpdateCreativeAdNotificationCategory(
-      const ads::CreativeAdNotificationInfo& info,
-      const std::string& category);
+      const CreativeAdNotificationCategoryKey& key);
 
   bool CreateCreativeAdNotificationCategoriesCategoryIndex();
 
+  bool CreateCreativeAdNotificationsUuidIndex();
+
+  bool CreateEligibleCategoriesTable();
+  bool UpdateEligibleCategories(
+      const std::vector<std::string>& categories);
+
   bool CreateAdConversionsTable();
-  bool TruncateAdConversionsTable();
+  bool GetAdConversionRows(
+      AdConversionMap* ad_conversions);
+  bool DeleteAdConversion(
+      const int64_t id);
   bool InsertOrUpdateAdConversion(
       const ads::AdConversionInfo& info);
 
-  std::string CreateBindingParameterPlaceholders(
-      const size_t count);
+  bool UpdateCategories(
+      const ads::BundleState& bundle_state);
+  bool UpdateCreativeAdNotifications(
+      const ads::BundleState& bundle_state);
+  bool UpdateCreativeAdNotificationCategories(
+      const ads::BundleState& bundle_state);
+  bool UpdateAdConversions(
+      const ads::BundleState& bundle_state);
+
+  // Returns the ratio of free pages to total pages in the database file
+  double GetFreePageRatio();
+
+  // Vacuums the database if enough pages have been freed to make reclaiming
+  // them worthwhile
+  void MaybeVacuum();
 
   sql::Database& GetDB();
   sql::MetaTable& GetMetaTable();
@@ -102,6 +157,7 @@ class BundleStateDatabase {
   bool MigrateV2toV3();
   bool MigrateV3toV4();
   bool MigrateV4toV5();
+  bool MigrateV5toV6();
 
   sql::Database db_;
   sql::MetaTable meta_table_;
@@ -0,0 +1,285 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveAdsBundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+namespace {
+
+const char* const kCategories[] = {
+  "Technology & Computing",
+  "Technology & Computing-Software",
+  "Travel",
+  "Personal Finance-Banking"
+};
+
+const char* const kTableQueries[] = {
+  "SELECT name FROM category ORDER BY name",
+  "SELECT creative_set_id, advertiser, notification_text, notification_url, "
+      "start_timestamp, end_timestamp, uuid, region, campaign_id, daily_cap, "
+      "advertiser_id, per_day, total_max FROM ad_info ORDER BY uuid, region",
+  "SELECT ad_info_uuid, category_name FROM ad_info_category "
+      "ORDER BY ad_info_uuid, category_name",
+  "SELECT creative_set_id, type, url_pattern, observation_window "
+      "FROM ad_conversions "
+      "ORDER BY creative_set_id, type, url_pattern, observation_window"
+};
+
+ads::CreativeAdNotificationInfo BuildCreativeAdNotification(
+    const int index,
+    const std::string& prefix) {
+  ads::CreativeAdNotificationInfo info;
+  const std::string id = base::NumberToString(index);
+  info.creative_instance_id = prefix + "creative_instance_" + id;
+  info.creative_set_id = prefix + "creative_set_" + id;
+  info.campaign_id = prefix + "campaign_" + id;
+  info.start_at_timestamp = "2020-01-01T00:00:00Z";
+  info.end_at_timestamp = "2030-12-31T23:59:59Z";
+  info.daily_cap = 1 + index % 3;
+  info.advertiser_id = prefix + "advertiser_" + id;
+  info.per_day = 2 + index % 5;
+  info.total_max = 10 + index;
+  info.geo_targets = { "US", "GB" };
+  info.target_url = "https://brave.com/" + id;
+  info.title = "Title " + id;
+  info.body = "Body " + id;
+  return info;
+}
+
+ads::BundleState BuildBundleState(
+    const int count,
+    const std::string& prefix) {
+  ads::BundleState bundle_state;
+
+  for (int i = 0; i < count; i++) {
+    const std::string category = kCategories[i % base::size(kCategories)];
+    bundle_state.creative_ad_notifications[category].push_back(
+        BuildCreativeAdNotification(i, prefix));
+
+    ads::AdConversionInfo ad_conversion;
+    ad_conversion.creative_set_id = prefix + "creative_set_" +
+        base::NumberToString(i);
+    ad_conversion.type = "postview";
+    ad_conversion.url_pattern = "https://brave.com/*";
+    ad_conversion.observation_window = 30;
+    bundle_state.ad_conversions.push_back(ad_conversion);
+  }
+
+  return bundle_state;
+}
+
+}  // namespace
+
+class BraveAdsBundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  BraveAdsBundleStateDatabaseTest() = default;
+
+  ~BraveAdsBundleStateDatabaseTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  // Saves each bundle state in turn to a new database and returns the
+  // resulting database contents
+  std::string SaveBundleStates(
+      const std::string& name,
+      const std::vector<ads::BundleState>& bundle_states) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+
+    {
+      BundleStateDatabase database(path);
+      for (const auto& bundle_state : bundle_states) {
+        EXPECT_TRUE(database.SaveBundleState(bundle_state));
+      }
+    }
+
+    return DumpDatabase(path);
+  }
+
+  std::string DumpDatabase(
+      const base::FilePath& path) {
+    sql::Database db;
+    EXPECT_TRUE(db.Open(path));
+
+    std::string dump;
+    for (const auto* query : kTableQueries) {
+      sql::Statement statement(db.GetUniqueStatement(query));
+      while (statement.Step()) {
+        for (int i = 0; i < statement.ColumnCount(); i++) {
+          dump += statement.ColumnString(i) + "|";
+        }
+
+        dump += "\n";
+      }
+
+      dump += "--\n";
+    }
+
+    return dump;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    UnchangedCatalogMatchesFullRebuild) {
+  // Arrange
+  const ads::BundleState bundle_state = BuildBundleState(100, "");
+
+  // Act
+  const std::string incremental = SaveBundleStates("incremental",
+      { bundle_state, bundle_state });
+
+  // Assert
+  const std::string rebuild = SaveBundleStates("rebuild", { bundle_state });
+  EXPECT_EQ(rebuild, incremental);
+}
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    SlightlyChangedCatalogMatchesFullRebuild) {
+  // Arrange
+  const ads::BundleState bundle_state = BuildBundleState(100, "");
+
+  ads::BundleState changed_bundle_state = bundle_state;
+  auto& creative_ads =
+      changed_bundle_state.creative_ad_notifications[kCategories[0]];
+  creative_ads.front().title = "Changed title";
+  creative_ads.front().geo_targets = { "US" };
+  creative_ads.back().end_at_timestamp = "2031-01-01T00:00:00Z";
+  creative_ads.push_back(BuildCreativeAdNotification(1000, ""));
+  changed_bundle_state.creative_ad_notifications[kCategories[1]].pop_back();
+  changed_bundle_state.creative_ad_notifications.erase(kCategories[2]);
+  changed_bundle_state.ad_conversions.pop_back();
+  changed_bundle_state.ad_conversions.push_back(
+      changed_bundle_state.ad_conversions.front());
+
+  // Act
+  const std::string incremental = SaveBundleStates("incremental",
+      { bundle_state, changed_bundle_state });
+
+  // Assert
+  const std::string rebuild = SaveBundleStates("rebuild",
+      { changed_bundle_state });
+  EXPECT_EQ(rebuild, incremental);
+}
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    ReplacedCatalogMatchesFullRebuild) {
+  // Arrange
+  const ads::BundleState bundle_state = BuildBundleState(100, "old_");
+  const ads::BundleState replaced_bundle_state = BuildBundleState(50, "new_");
+
+  // Act
+  const std::string incremental = SaveBundleStates("incremental",
+      { bundle_state, replaced_bundle_state });
+
+  // Assert
+  const std::string rebuild = SaveBundleStates("rebuild",
+      { replaced_bundle_state });
+  EXPECT_EQ(rebuild, incremental);
+}
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    EmptyCatalogClearsDatabase) {
+  // Arrange
+  const ads::BundleState bundle_state = BuildBundleState(100, "");
+
+  // Act
+  const std::string incremental = SaveBundleStates("incremental",
+      { bundle_state, ads::BundleState() });
+
+  // Assert
+  const std::string rebuild = SaveBundleStates("rebuild",
+      { ads::BundleState() });
+  EXPECT_EQ(rebuild, incremental);
+}
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    GetCreativeAdNotificationsForCategories) {
+  // Arrange
+  ads::BundleState bundle_state = BuildBundleState(100, "");
+  auto& creative_ads =
+      bundle_state.creative_ad_notifications[kCategories[0]];
+  creative_ads.front().end_at_timestamp = "2019-12-31T23:59:59Z";
+  creative_ads.back().start_at_timestamp = "2100-01-01T00:00:00Z";
+
+  BundleStateDatabase database(temp_dir_.GetPath().AppendASCII("database"));
+  ASSERT_TRUE(database.SaveBundleState(bundle_state));
+
+  // Act
+  ads::CreativeAdNotificationList ads;
+  ASSERT_TRUE(database.GetCreativeAdNotifications(
+      { kCategories[0], kCategories[1], kCategories[0], "Unknown" }, &ads));
+
+  // Assert
+
+  // Each creative ad notification is served once per geo target, excluding
+  // creative ad notifications outside of the time window
+  EXPECT_EQ((25 + 25 - 2) * 2u, ads.size());
+  for (const auto& ad : ads) {
+    EXPECT_TRUE(ad.category == kCategories[0] ||
+        ad.category == kCategories[1]);
+  }
+}
+
+TEST_F(BraveAdsBundleStateDatabaseTest,
+    GetCreativeAdNotificationsUsesIndexes) {
+  // Arrange
+  BundleStateDatabase database(temp_dir_.GetPath().AppendASCII("database"));
+  ASSERT_TRUE(database.SaveBundleState(BuildBundleState(100, "")));
+
+  // Act
+  std::vector<std::string> details;
+  ASSERT_TRUE(database.GetCreativeAdNotificationsQueryPlanForTesting(
+      &details));
+
+  // Assert
+
+  // Only the eligible categories temporary table may be scanned, all other
+  // tables must be searched using an index
+  ASSERT_FALSE(details.empty());
+  bool uses_ad_info_category_index = false;
+  bool uses_ad_info_index = false;
+  for (const auto& detail : details) {
+    if (detail.find("ad_info_category_category_name_index") !=
+        std::string::npos) {
+      uses_ad_info_category_index = true;
+    }
+
+    if (detail.find("ad_info_uuid_timestamp_index") != std::string::npos) {
+      uses_ad_info_index = true;
+    }
+
+    if (!base::StartsWith(detail, "SCAN", base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+
+    EXPECT_NE(std::string::npos, detail.find("eligible_category")) << detail;
+  }
+
+  EXPECT_TRUE(uses_ad_info_category_index);
+  EXPECT_TRUE(uses_ad_info_index);
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,58 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/page_text_util.h"
+
+#include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "brave/components/brave_ads/common/switches.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_ads {
+
+namespace {
+
+// Classification only uses the leading text of a page, so there is no need to
+// extract, transfer and normalize megabytes of text for large pages
+const size_t kDefaultPageTextMaxLength = 256 * 1024;
+
+}  // namespace
+
+size_t GetPageTextMaxLength() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  if (!command_line.HasSwitch(switches::kPageTextMaxLength)) {
+    return kDefaultPageTextMaxLength;
+  }
+
+  const std::string value =
+      command_line.GetSwitchValueASCII(switches::kPageTextMaxLength);
+
+  size_t max_length;
+  if (!base::StringToSizeT(value, &max_length) || max_length == 0) {
+    return kDefaultPageTextMaxLength;
+  }
+
+  return max_length;
+}
+
+std::string GetPageTextScript(
+    const size_t max_length) {
+  return base::StringPrintf("document.body.innerText.substring(0, %zu)",
+      max_length);
+}
+
+std::string NormalizePageText(
+    std::string text) {
+  RE2::GlobalReplace(&text, "[[:cntrl:]]|[[:space:]]|\\\\x[[:xdigit:]]"
+      "[[:xdigit:]]|\\\\(t|n|v|f|r)", " ");
+
+  return base::CollapseWhitespaceASCII(text, false);
+}
+
+}  // namespace brave_ads
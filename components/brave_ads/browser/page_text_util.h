@@ -0,0 +1,33 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_PAGE_TEXT_UTIL_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_PAGE_TEXT_UTIL_H_
+
+#include <stddef.h>
+
+#include <string>
+
+namespace brave_ads {
+
+// Returns the maximum number of characters of page text extracted for
+// classification, which can be overridden using the
+// |switches::kPageTextMaxLength| command line switch
+size_t GetPageTextMaxLength();
+
+// Returns the JavaScript used to extract at most |max_length| characters of
+// page text
+std::string GetPageTextScript(
+    const size_t max_length);
+
+// Replaces control characters and escape sequences with spaces and collapses
+// whitespace. This can be slow for large pages so should not be called on the
+// UI thread
+std::string NormalizePageText(
+    std::string text);
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_PAGE_TEXT_UTIL_H_
@@ -0,0 +1,102 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/page_text_util.h"
+
+#include <string>
+
+#include "base/command_line.h"
+#include "base/test/scoped_command_line.h"
+#include "brave/components/brave_ads/common/switches.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveAdsPageTextUtilTest.*
+
+namespace brave_ads {
+
+TEST(BraveAdsPageTextUtilTest,
+    NormalizePageText) {
+  // Arrange
+  const std::string text =
+      "  The\tquick\nbrown\\x0Afox\\njumps \x01over  the\r\nlazy dog  ";
+
+  // Act
+  const std::string normalized_text = NormalizePageText(text);
+
+  // Assert
+  EXPECT_EQ("The quick brown fox jumps over the lazy dog", normalized_text);
+}
+
+TEST(BraveAdsPageTextUtilTest,
+    NormalizeMultiMegabytePageText) {
+  // Arrange
+  std::string text;
+  std::string expected_text;
+  while (text.size() < 4 * 1024 * 1024) {
+    text += "Lorem ipsum\t\tdolor sit amet,\n\nconsectetur adipiscing elit.\n";
+    expected_text +=
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit. ";
+  }
+
+  expected_text.pop_back();
+
+  // Act
+  const std::string normalized_text = NormalizePageText(text);
+
+  // Assert
+  EXPECT_EQ(expected_text, normalized_text);
+}
+
+TEST(BraveAdsPageTextUtilTest,
+    GetPageTextScript) {
+  // Arrange
+
+  // Act
+  const std::string script = GetPageTextScript(1024);
+
+  // Assert
+  EXPECT_EQ("document.body.innerText.substring(0, 1024)", script);
+}
+
+TEST(BraveAdsPageTextUtilTest,
+    GetDefaultPageTextMaxLength) {
+  // Arrange
+
+  // Act
+  const size_t max_length = GetPageTextMaxLength();
+
+  // Assert
+  EXPECT_EQ(256u * 1024u, max_length);
+}
+
+TEST(BraveAdsPageTextUtilTest,
+    GetPageTextMaxLengthFromCommandLine) {
+  // Arrange
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitchASCII(
+      switches::kPageTextMaxLength, "4096");
+
+  // Act
+  const size_t max_length = GetPageTextMaxLength();
+
+  // Assert
+  EXPECT_EQ(4096u, max_length);
+}
+
+TEST(BraveAdsPageTextUtilTest,
+    GetPageTextMaxLengthFromInvalidCommandLine) {
+  // Arrange
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitchASCII(
+      switches::kPageTextMaxLength, "invalid");
+
+  // Act
+  const size_t max_length = GetPageTextMaxLength();
+
+  // Assert
+  EXPECT_EQ(256u * 1024u, max_length);
+}
+
+}  // namespace brave_ads
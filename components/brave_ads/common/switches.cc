@@ -13,6 +13,7 @@ const char kProduction[] = "brave-ads-production";
 const char kStaging[] = "brave-ads-staging";
 const char kDevelopment[] = "brave-ads-development";
 const char kDebug[] = "brave-ads-debug";
+const char kPageTextMaxLength[] = "brave-ads-page-text-max-length";
 
 }  // namespace switches
 
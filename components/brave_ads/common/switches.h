@@ -15,6 +15,7 @@ extern const char kStaging[];
 extern const char kDevelopment[];
 extern const char kDebug[];
 extern const char kTesting[];
+extern const char kPageTextMaxLength[];
 
 }  // namespace switches
 
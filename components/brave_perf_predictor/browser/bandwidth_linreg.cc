@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -37,7 +38,25 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
-double LinregPredictVector(const std::array<double, feature_count>& features) {
+base::Optional<size_t> GetThirdPartyBlockedIndex(
+    const std::string& third_party_name) {
+  static const base::NoDestructor<base::flat_map<std::string, size_t>>
+      blocked_indexes([] {
+        std::vector<std::pair<std::string, size_t>> indexes;
+        for (size_t i = 0; i < relevant_entities.size(); i++) {
+          indexes.emplace_back(relevant_entities[i],
+                               kThirdPartyBlockedFirst + i);
+        }
+        return base::flat_map<std::string, size_t>(std::move(indexes));
+      }());
+
+  const auto it = blocked_indexes->find(third_party_name);
+  if (it == blocked_indexes->end())
+    return base::nullopt;
+  return it->second;
+}
+
+double LinregPredictVector(const FeatureVector& features) {
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
   std::copy(features.begin(), features.begin() + standardise_feat_count,
@@ -66,7 +85,7 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
 }
 
 double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
-  std::array<double, feature_count> feature_vector{};
+  FeatureVector feature_vector{};
   for (unsigned int i = 0; i < feature_count; i++) {
     auto it = features.find(feature_sequence.at(i));
     if (it != features.end())
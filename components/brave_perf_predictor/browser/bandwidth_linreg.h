@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,10 +19,80 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Positions of the page load features in the feature vector, in the order of
+// |feature_sequence|. Blocked third parties follow the page load features in
+// the order of |relevant_entities|
+enum FeatureIndex : size_t {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+  kThirdPartyBlockedFirst,
+};
+
+static_assert(kThirdPartyBlockedFirst == standardise_feat_count,
+              "Page load features must be the standardised features");
+static_assert(kThirdPartyBlockedFirst + std::tuple_size<
+                  decltype(relevant_entities)>::value ==
+                  static_cast<size_t>(feature_count),
+              "Every relevant third party must have a blocked feature");
+
+constexpr const char* kPageLoadFeatureNames[kThirdPartyBlockedFirst] = {
+    "adblockRequests",
+    "metrics.firstMeaningfulPaint",
+    "metrics.observedDomContentLoaded",
+    "metrics.observedFirstVisualChange",
+    "metrics.observedLoad",
+    "resources.document.requestCount",
+    "resources.document.size",
+    "resources.font.requestCount",
+    "resources.font.size",
+    "resources.image.requestCount",
+    "resources.image.size",
+    "resources.media.requestCount",
+    "resources.media.size",
+    "resources.other.requestCount",
+    "resources.other.size",
+    "resources.script.requestCount",
+    "resources.script.size",
+    "resources.stylesheet.requestCount",
+    "resources.stylesheet.size",
+    "resources.third-party.requestCount",
+    "resources.third-party.size",
+    "resources.total.requestCount",
+    "resources.total.size",
+};
+
+using FeatureVector = std::array<double, feature_count>;
+
+// Returns the position of the blocked feature of |third_party_name| or
+// nullopt if the model does not know the third party
+base::Optional<size_t> GetThirdPartyBlockedIndex(
+    const std::string& third_party_name);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
-double LinregPredictVector(const std::array<double, feature_count>& features);
+double LinregPredictVector(const FeatureVector& features);
 
 // Computes prediction based on key-value map of features.
 // It translates the map to a feature vector internally, and
@@ -104,4 +104,17 @@ TEST(BraveSavingsPredictorTest, HandesSpecificFeaturemapExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndexesMatchFeatureSequence) {
+  for (size_t i = 0; i < kThirdPartyBlockedFirst; i++) {
+    EXPECT_EQ(feature_sequence.at(i), kPageLoadFeatureNames[i]);
+  }
+  for (const auto& entity : relevant_entities) {
+    const auto index = GetThirdPartyBlockedIndex(entity);
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(feature_sequence.at(index.value()),
+              "thirdParties." + entity + ".blocked");
+  }
+  EXPECT_FALSE(GetThirdPartyBlockedIndex("Unknown Third Party").has_value());
+}
+
 }  // namespace brave_perf_predictor
@@ -6,20 +6,192 @@
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/logging.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
 #include "content/public/common/resource_load_info.mojom.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
+namespace {
+
+struct RecordedResource {
+  std::string url;
+  content::ResourceType type;
+  int64_t raw_body_bytes;
+  bool blocked;
+};
+
+// Page load feature dump as recorded from the resource events of a page
+struct RecordedPageLoad {
+  std::string main_frame_url;
+  int dom_content_loaded;
+  int first_contentful_paint;
+  int first_meaningful_paint;
+  int load;
+  std::vector<RecordedResource> resources;
+};
+
+std::vector<RecordedPageLoad> GetRecordedPageLoads() {
+  return {
+      {"https://news.example.com/",
+       420,
+       380,
+       610,
+       1840,
+       {
+           {"https://news.example.com/", content::ResourceType::kMainFrame,
+            48211, false},
+           {"https://news.example.com/main.css",
+            content::ResourceType::kStylesheet, 23301, false},
+           {"https://news.example.com/app.js", content::ResourceType::kScript,
+            187220, false},
+           {"https://www.google-analytics.com/analytics.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://connect.facebook.net/en_US/fbevents.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://securepubads.g.doubleclick.net/tag/js/gpt.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://fonts.gstatic.com/s/roboto.woff2",
+            content::ResourceType::kFontResource, 15344, false},
+           {"https://news.example.com/hero.jpg", content::ResourceType::kImage,
+            201553, false},
+           {"https://www.youtube.com/embed/abc",
+            content::ResourceType::kSubFrame, 0, true},
+           {"https://news.example.com/clip.mp4", content::ResourceType::kMedia,
+            1204111, false},
+           {"https://news.example.com/beacon", content::ResourceType::kPing,
+            12, false},
+       }},
+      {"https://shop.example.org/",
+       910,
+       700,
+       1200,
+       3100,
+       {
+           {"https://shop.example.org/", content::ResourceType::kMainFrame,
+            91002, false},
+           {"https://stackpath.bootstrapcdn.com/bootstrap.min.css",
+            content::ResourceType::kStylesheet, 19211, false},
+           {"https://code.jquery.com/jquery.min.js",
+            content::ResourceType::kScript, 30110, false},
+           {"https://www.googletagmanager.com/gtm.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://static.hotjar.com/c/hotjar.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://unknown-tracker.example.net/t.js",
+            content::ResourceType::kScript, 0, true},
+           {"https://shop.example.org/product.png",
+            content::ResourceType::kImage, 88120, false},
+       }},
+  };
+}
+
+// Generates a page load with |count| resources, every fifth one blocked
+RecordedPageLoad GetLargePageLoad(const int count) {
+  const std::vector<std::string> blocked_urls = {
+      "https://www.google-analytics.com/analytics.js",
+      "https://connect.facebook.net/en_US/fbevents.js",
+      "https://securepubads.g.doubleclick.net/tag/js/gpt.js",
+      "https://static.hotjar.com/c/hotjar.js",
+  };
+  const std::vector<content::ResourceType> types = {
+      content::ResourceType::kScript, content::ResourceType::kImage,
+      content::ResourceType::kStylesheet, content::ResourceType::kFontResource,
+      content::ResourceType::kXhr};
+
+  RecordedPageLoad page_load = {"https://large.example.com/", 800, 650, 900,
+                                4000, {}};
+  for (int i = 0; i < count; i++) {
+    if (i % 5 == 0) {
+      page_load.resources.push_back({blocked_urls[i % blocked_urls.size()],
+                                     content::ResourceType::kScript, 0, true});
+    } else {
+      page_load.resources.push_back(
+          {"https://cdn" + base::NumberToString(i % 3) +
+               ".example.com/resource" + base::NumberToString(i),
+           types[i % types.size()], 1000 + i * 10, false});
+    }
+  }
+  return page_load;
+}
+
+// The string keyed featurisation which the feature vector replaced
+base::flat_map<std::string, double> GetReferenceFeatures(
+    const NamedThirdPartyRegistry& registry,
+    const RecordedPageLoad& page_load) {
+  base::flat_map<std::string, double> features;
+  features["metrics.firstMeaningfulPaint"] = page_load.first_meaningful_paint;
+  features["metrics.observedDomContentLoaded"] = page_load.dom_content_loaded;
+  features["metrics.observedFirstVisualChange"] =
+      page_load.first_contentful_paint;
+  features["metrics.observedLoad"] = page_load.load;
+
+  const GURL main_frame_url(page_load.main_frame_url);
+  for (const auto& resource : page_load.resources) {
+    if (resource.blocked) {
+      features["adblockRequests"] += 1;
+      const auto tp_name = registry.GetThirdParty(resource.url);
+      if (tp_name.has_value())
+        features["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    }
+
+    if (!net::registry_controlled_domains::SameDomainOrHost(
+            main_frame_url, GURL(resource.url),
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+      features["resources.third-party.requestCount"] += 1;
+      features["resources.third-party.size"] += resource.raw_body_bytes;
+    }
+    features["resources.total.requestCount"] += 1;
+    features["resources.total.size"] += resource.raw_body_bytes;
+
+    std::string resource_type;
+    switch (resource.type) {
+      case content::ResourceType::kMainFrame:
+      case content::ResourceType::kSubFrame:
+        resource_type = "document";
+        break;
+      case content::ResourceType::kStylesheet:
+        resource_type = "stylesheet";
+        break;
+      case content::ResourceType::kScript:
+        resource_type = "script";
+        break;
+      case content::ResourceType::kImage:
+        resource_type = "image";
+        break;
+      case content::ResourceType::kFontResource:
+        resource_type = "font";
+        break;
+      case content::ResourceType::kMedia:
+        resource_type = "media";
+        break;
+      default:
+        resource_type = "other";
+        break;
+    }
+    features["resources." + resource_type + ".requestCount"] += 1;
+    features["resources." + resource_type + ".size"] +=
+        resource.raw_body_bytes;
+  }
+  return features;
+}
+
+}  // namespace
+
 class BandwidthSavingsPredictorTest : public ::testing::Test {
  public:
   BandwidthSavingsPredictorTest() {
@@ -32,6 +204,30 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
   }
 
  protected:
+  void ReplayPageLoad(const RecordedPageLoad& page_load) {
+    auto timing = page_load_metrics::CreatePageLoadTiming();
+    timing->document_timing->dom_content_loaded_event_start =
+        base::TimeDelta::FromMilliseconds(page_load.dom_content_loaded);
+    timing->paint_timing->first_contentful_paint =
+        base::TimeDelta::FromMilliseconds(page_load.first_contentful_paint);
+    timing->paint_timing->first_meaningful_paint =
+        base::TimeDelta::FromMilliseconds(page_load.first_meaningful_paint);
+    timing->document_timing->load_event_start =
+        base::TimeDelta::FromMilliseconds(page_load.load);
+    predictor_->OnPageLoadTimingUpdated(*timing);
+
+    const GURL main_frame_url(page_load.main_frame_url);
+    for (const auto& resource : page_load.resources) {
+      if (resource.blocked)
+        predictor_->OnSubresourceBlocked(resource.url);
+      auto info =
+          predictors::CreateResourceLoadInfo(resource.url, resource.type);
+      info->raw_body_bytes = resource.raw_body_bytes;
+      info->total_received_bytes = resource.raw_body_bytes;
+      predictor_->OnResourceLoadComplete(main_frame_url, *info);
+    }
+  }
+
   base::test::TaskEnvironment env_;
   std::unique_ptr<NamedThirdPartyRegistry> tp_registry_;
   std::unique_ptr<BandwidthSavingsPredictor> predictor_;
@@ -39,51 +235,53 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 1);
+  EXPECT_EQ(predictor_->features_[GetThirdPartyBlockedIndex("Google Analytics")
+                                      .value()],
             1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.interactive"], 0);
+  EXPECT_EQ(predictor_->features_[kFirstMeaningfulPaint], 0);
+  EXPECT_EQ(predictor_->features_[kObservedDomContentLoaded], 0);
+  EXPECT_EQ(predictor_->features_[kObservedFirstVisualChange], 0);
+  EXPECT_EQ(predictor_->features_[kObservedLoad], 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(predictor_->features_[kObservedDomContentLoaded], 1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(predictor_->features_[kObservedLoad], 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(predictor_->features_[kFirstMeaningfulPaint], 1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(predictor_->features_[kObservedFirstVisualChange], 800);
 
+  // The model has no time to interactive feature
+  const FeatureVector features = predictor_->features_;
   timing->interactive_timing->interactive =
       base::TimeDelta::FromMilliseconds(2500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.interactive"], 2500);
+  EXPECT_EQ(features, predictor_->features_);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -91,9 +289,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       "https://brave.com/style.css", content::ResourceType::kStylesheet);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 0);
+  EXPECT_EQ(predictor_->features_[kStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetSize], 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -101,14 +299,14 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kScriptRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetSize], 1000);
+  EXPECT_EQ(predictor_->features_[kScriptSize], 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(predictor_->features_[kTotalRequestCount], 2);
+  EXPECT_EQ(predictor_->features_[kTotalSize], 2001);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -161,4 +359,43 @@ TEST_F(BandwidthSavingsPredictorTest, PredictNonZero) {
   EXPECT_NE(predictor_->PredictSavingsBytes(), 0);
 }
 
+TEST_F(BandwidthSavingsPredictorTest, MatchesFeatureMapPredictions) {
+  for (const auto& page_load : GetRecordedPageLoads()) {
+    predictor_->Reset();
+    ReplayPageLoad(page_load);
+
+    const auto reference = GetReferenceFeatures(*tp_registry_, page_load);
+    for (size_t i = 0; i < feature_sequence.size(); i++) {
+      const auto it = reference.find(feature_sequence[i]);
+      EXPECT_EQ(it == reference.end() ? 0 : it->second,
+                predictor_->features_[i])
+          << page_load.main_frame_url << " " << feature_sequence[i];
+    }
+    EXPECT_EQ(LinregPredictNamed(reference),
+              LinregPredictVector(predictor_->features_));
+  }
+}
+
+TEST_F(BandwidthSavingsPredictorTest, PredictLargePageLoad) {
+  const int kResourcesCount = 500;
+  const int kPageLoadsCount = 100;
+  const RecordedPageLoad page_load = GetLargePageLoad(kResourcesCount);
+
+  base::ElapsedTimer timer;
+  double prediction = 0;
+  for (int i = 0; i < kPageLoadsCount; i++) {
+    predictor_->Reset();
+    ReplayPageLoad(page_load);
+    prediction = predictor_->PredictSavingsBytes();
+  }
+  LOG(INFO) << kPageLoadsCount << " page loads of " << kResourcesCount
+            << " resources featurised and predicted in "
+            << timer.Elapsed().InMilliseconds() << "ms";
+
+  const auto reference = GetReferenceFeatures(*tp_registry_, page_load);
+  EXPECT_EQ(LinregPredictNamed(reference),
+            LinregPredictVector(predictor_->features_));
+  EXPECT_GE(prediction, 0);
+}
+
 }  // namespace brave_perf_predictor
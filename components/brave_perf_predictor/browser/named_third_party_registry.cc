@@ -5,7 +5,7 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <utility>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
@@ -16,6 +16,7 @@
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/trace_event/memory_usage_estimator.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/grit/brave_components_resources.h"
@@ -27,11 +28,12 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+using EntityId = NamedThirdPartyRegistry::EntityId;
+
+NamedThirdPartyRegistry::Mappings ParseMappings(
+    const base::StringPiece entities,
+    bool discard_irrelevant) {
+  NamedThirdPartyRegistry::Mappings mappings;
 
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
@@ -40,7 +42,8 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     return {};
   }
 
-  // Collect the mappings
+  // Collect the mappings, each entity name is stored once
+  base::flat_map<base::StringPiece, EntityId> entity_ids;
   for (auto& entity : document->GetList()) {
     const std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
@@ -53,6 +56,12 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const auto entity_id_entry =
+        entity_ids.emplace(*entity_name, mappings.entity_names.size());
+    if (entity_id_entry.second)
+      mappings.entity_names.push_back(*entity_name);
+    const EntityId entity_id = entity_id_entry.first->second;
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
@@ -60,7 +69,7 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
       const base::StringPiece entity_domain(entity_domain_it.GetString());
 
       const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
+          mappings.entity_by_domain.emplace(entity_domain, entity_id);
       if (!inserted.second) {
         VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
       }
@@ -68,25 +77,24 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
+      auto root_entity_entry = mappings.entity_by_root_domain.find(root_domain);
+      if (root_entity_entry != mappings.entity_by_root_domain.end() &&
+          root_entity_entry->second != entity_id) {
         // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
+        mappings.entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
+        mappings.entity_by_root_domain.emplace(root_domain, entity_id);
       }
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  mappings.entity_names.shrink_to_fit();
+  mappings.entity_by_domain.shrink_to_fit();
+  mappings.entity_by_root_domain.shrink_to_fit();
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+NamedThirdPartyRegistry::Mappings ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -99,58 +107,88 @@ ParseFromResource(int resource_id) {
 
 }  // namespace
 
+NamedThirdPartyRegistry::Mappings::Mappings() = default;
+
+NamedThirdPartyRegistry::Mappings::Mappings(Mappings&& other) = default;
+
+NamedThirdPartyRegistry::Mappings&
+NamedThirdPartyRegistry::Mappings::operator=(Mappings&& other) = default;
+
+NamedThirdPartyRegistry::Mappings::~Mappings() = default;
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_ = Mappings();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  mappings_ = ParseMappings(entities, discard_irrelevant);
+  if (mappings_.entity_by_domain.size() == 0 ||
+      mappings_.entity_by_root_domain.size() == 0)
     return false;
 
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+void NamedThirdPartyRegistry::UpdateMappings(Mappings mappings) {
+  mappings_ = std::move(mappings);
+  VLOG(2) << "Loaded " << mappings_.entity_names.size() << " entities with "
+          << mappings_.entity_by_domain.size() << " mappings by domain and "
+          << mappings_.entity_by_root_domain.size() << " by root domain";
   initialized_ = true;
 }
 
 base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
+  const auto entity_id = GetThirdPartyId(GURL(request_url));
+  if (!entity_id.has_value())
+    return base::nullopt;
+
+  return GetEntityName(entity_id.value());
+}
+
+base::Optional<EntityId> NamedThirdPartyRegistry::GetThirdPartyId(
+    const GURL& url) const {
+  if (!url.is_valid() || !url.has_host())
+    return base::nullopt;
+
+  return GetThirdPartyIdForHost(url.host_piece());
+}
+
+base::Optional<EntityId> NamedThirdPartyRegistry::GetThirdPartyIdForHost(
+    const base::StringPiece host) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
     return base::nullopt;
   }
 
-  const GURL url(request_url);
-  if (!url.is_valid())
-    return base::nullopt;
-
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  auto domain_entry = mappings_.entity_by_domain.find(host);
+  if (domain_entry != mappings_.entity_by_domain.end())
+    return domain_entry->second;
 
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
+      host, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
-  }
+  auto root_domain_entry = mappings_.entity_by_root_domain.find(root_domain);
+  if (root_domain_entry != mappings_.entity_by_root_domain.end())
+    return root_domain_entry->second;
 
   return base::nullopt;
 }
 
+const std::string& NamedThirdPartyRegistry::GetEntityName(EntityId id) const {
+  DCHECK_LT(id, mappings_.entity_names.size());
+  return mappings_.entity_names[id];
+}
+
+size_t NamedThirdPartyRegistry::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(mappings_.entity_names) +
+         base::trace_event::EstimateMemoryUsage(mappings_.entity_by_domain) +
+         base::trace_event::EstimateMemoryUsage(
+             mappings_.entity_by_root_domain);
+}
+
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
@@ -7,20 +7,41 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "components/keyed_service/core/keyed_service.h"
 
+class GURL;
+
 namespace brave_perf_predictor {
 
 // Retrieves publicly known Third Party (organisation) for a given URL, using
 // data from the Third Party Web repository
 // (https://github.com/patrickhulce/third-party-web).
+//
+// Entity names are interned, the domain indexes map to an |EntityId| which is
+// resolved to the name with |GetEntityName|.
 class NamedThirdPartyRegistry : public KeyedService {
  public:
+  using EntityId = size_t;
+
+  struct Mappings {
+    Mappings();
+    Mappings(Mappings&& other);
+    Mappings& operator=(Mappings&& other);
+    ~Mappings();
+
+    std::vector<std::string> entity_names;
+    base::flat_map<std::string, EntityId> entity_by_domain;
+    // Registrable domain to entity, for subdomains not listed explicitly
+    base::flat_map<std::string, EntityId> entity_by_root_domain;
+  };
+
   NamedThirdPartyRegistry();
   ~NamedThirdPartyRegistry() override;
 
@@ -36,16 +57,24 @@ class NamedThirdPartyRegistry : public KeyedService {
   base::Optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
 
+  // Lookups for callers which already have a parsed URL or host
+  base::Optional<EntityId> GetThirdPartyId(const GURL& url) const;
+  base::Optional<EntityId> GetThirdPartyIdForHost(
+      const base::StringPiece host) const;
+  const std::string& GetEntityName(EntityId id) const;
+
+  size_t EstimateMemoryUsage() const;
+
  private:
+  FRIEND_TEST_ALL_PREFIXES(NamedThirdPartyRegistryTest,
+                           InterningReducesMemoryUsage);
+
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(Mappings mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  Mappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
@@ -5,10 +5,18 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
+#include <string>
+
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
 #include "base/path_service.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
@@ -119,4 +127,82 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyFromParsedHost) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  extractor->LoadMappings(test_mapping, false);
+
+  auto entity_id = extractor->GetThirdPartyIdForHost("www.google-analytics.com");
+  ASSERT_TRUE(entity_id.has_value());
+  EXPECT_EQ(extractor->GetEntityName(entity_id.value()), "Google Analytics");
+
+  entity_id = extractor->GetThirdPartyId(GURL("https://test.m.facebook.com/"));
+  ASSERT_TRUE(entity_id.has_value());
+  EXPECT_EQ(extractor->GetEntityName(entity_id.value()), "Facebook");
+
+  // Domains of one entity share its interned name
+  EXPECT_EQ(extractor->GetThirdPartyIdForHost("connect.facebook.net"),
+            extractor->GetThirdPartyIdForHost("staticxx.facebook.com"));
+
+  EXPECT_FALSE(extractor->GetThirdPartyIdForHost("example.com").has_value());
+  EXPECT_FALSE(extractor->GetThirdPartyId(GURL()).has_value());
+}
+
+TEST(NamedThirdPartyRegistryTest, ResolvesEveryDomainOfBundledDataset) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  auto dataset = LoadFile();
+  ASSERT_TRUE(extractor->LoadMappings(dataset, false));
+
+  base::Optional<base::Value> document = base::JSONReader::Read(dataset);
+  ASSERT_TRUE(document && document->is_list());
+
+  // Listed domains belong to the first entity listing them
+  base::flat_map<std::string, std::string> expected_entities;
+  for (const auto& entity : document->GetList()) {
+    const std::string* name = entity.FindStringPath("name");
+    const base::Value* domains = entity.FindListPath("domains");
+    if (!name || !domains)
+      continue;
+    for (const auto& domain : domains->GetList()) {
+      if (domain.is_string())
+        expected_entities.emplace(domain.GetString(), *name);
+    }
+  }
+  ASSERT_FALSE(expected_entities.empty());
+
+  for (const auto& expected : expected_entities) {
+    const auto entity_id = extractor->GetThirdPartyIdForHost(expected.first);
+    ASSERT_TRUE(entity_id.has_value()) << expected.first;
+    EXPECT_EQ(expected.second, extractor->GetEntityName(entity_id.value()))
+        << expected.first;
+    EXPECT_EQ(expected.second,
+              extractor->GetThirdParty("https://" + expected.first + "/"));
+  }
+}
+
+TEST(NamedThirdPartyRegistryTest, InterningReducesMemoryUsage) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  auto dataset = LoadFile();
+  ASSERT_TRUE(extractor->LoadMappings(dataset, false));
+
+  // Layout which stored a copy of the entity name for every domain
+  base::flat_map<std::string, std::string> entity_by_domain;
+  for (const auto& entry : extractor->mappings_.entity_by_domain) {
+    entity_by_domain.emplace(entry.first,
+                             extractor->GetEntityName(entry.second));
+  }
+  base::flat_map<std::string, std::string> entity_by_root_domain;
+  for (const auto& entry : extractor->mappings_.entity_by_root_domain) {
+    entity_by_root_domain.emplace(entry.first,
+                                  extractor->GetEntityName(entry.second));
+  }
+  const size_t string_mappings_usage =
+      base::trace_event::EstimateMemoryUsage(entity_by_domain) +
+      base::trace_event::EstimateMemoryUsage(entity_by_root_domain);
+
+  LOG(INFO) << "Third party registry uses " << extractor->EstimateMemoryUsage()
+            << " bytes, " << string_mappings_usage
+            << " bytes with an entity name per domain";
+  EXPECT_LT(extractor->EstimateMemoryUsage(), string_mappings_usage);
+}
+
 }  // namespace brave_perf_predictor
@@ -0,0 +1,481 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/net/rewards_url_cache.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task_runner_util.h"
+#include "crypto/sha2.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace brave_rewards {
+
+namespace {
+
+const char kIndexFile[] = "index.json";
+const char kDownloadExtension[] = ".download";
+
+// Publisher lists are the largest ledger payloads and are far below this
+const int64_t kMaxBodySize = 32 * 1024 * 1024;
+
+const unsigned int kRetriesCountOnNetworkChange = 1;
+
+const char kBytesSavedKey[] = "bytes_saved";
+const char kEntriesKey[] = "entries";
+const char kETagKey[] = "etag";
+const char kLastModifiedKey[] = "last_modified";
+const char kHeadersKey[] = "headers";
+
+std::string GetBodyFileName(const std::string& url) {
+  return base::ToLowerASCII(base::HexEncode(
+      crypto::SHA256HashString(url).data(), crypto::kSHA256Length));
+}
+
+base::Value LoadIndexOnFileTaskRunner(const base::FilePath& path) {
+  base::Value index(base::Value::Type::DICTIONARY);
+
+  if (!base::DirectoryExists(path)) {
+    base::CreateDirectory(path);
+    return index;
+  }
+
+  // Downloads which were interrupted by a previous shutdown are never read
+  base::FileEnumerator downloads(path, false, base::FileEnumerator::FILES,
+      FILE_PATH_LITERAL("*.download"));
+  for (base::FilePath download = downloads.Next(); !download.empty();
+      download = downloads.Next()) {
+    base::DeleteFile(download, false);
+  }
+
+  std::string json;
+  if (!base::ReadFileToString(path.AppendASCII(kIndexFile), &json)) {
+    return index;
+  }
+
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_dict()) {
+    LOG(ERROR) << "Failed to parse rewards URL cache index";
+    return index;
+  }
+
+  // Drop entries whose body is gone, so they are never revalidated
+  base::Value* entries = value->FindDictKey(kEntriesKey);
+  if (entries) {
+    std::vector<std::string> missing_urls;
+    for (const auto& entry : entries->DictItems()) {
+      if (!base::PathExists(path.AppendASCII(GetBodyFileName(entry.first)))) {
+        missing_urls.push_back(entry.first);
+      }
+    }
+
+    for (const auto& url : missing_urls) {
+      entries->RemoveKey(url);
+    }
+  }
+
+  return std::move(*value);
+}
+
+base::Optional<std::string> ReadBodyOnFileTaskRunner(
+    const base::FilePath& body_path,
+    const base::FilePath& download_path) {
+  base::DeleteFile(download_path, false);
+
+  std::string body;
+  if (!base::ReadFileToString(body_path, &body)) {
+    return base::nullopt;
+  }
+
+  return body;
+}
+
+std::map<std::string, std::string> GetResponseHeaders(
+    const network::SimpleURLLoader* loader) {
+  std::map<std::string, std::string> headers;
+  if (!loader->ResponseInfo() || !loader->ResponseInfo()->headers) {
+    return headers;
+  }
+
+  size_t iter = 0;
+  std::string key;
+  std::string value;
+  while (loader->ResponseInfo()->headers->EnumerateHeaderLines(
+      &iter, &key, &value)) {
+    key = base::ToLowerASCII(key);
+    headers[key] = value;
+  }
+
+  return headers;
+}
+
+}  // namespace
+
+RewardsURLCache::Entry::Entry() = default;
+
+RewardsURLCache::Entry::Entry(const Entry& entry) = default;
+
+RewardsURLCache::Entry::~Entry() = default;
+
+RewardsURLCache::DownloadResult::DownloadResult() = default;
+
+RewardsURLCache::DownloadResult::DownloadResult(DownloadResult&& result) =
+    default;
+
+RewardsURLCache::DownloadResult& RewardsURLCache::DownloadResult::operator=(
+    DownloadResult&& result) = default;
+
+RewardsURLCache::DownloadResult::~DownloadResult() = default;
+
+// static
+RewardsURLCache::DownloadResult RewardsURLCache::ReadDownloadOnFileTaskRunner(
+    const base::FilePath& download_path,
+    const base::FilePath& body_path) {
+  DownloadResult result;
+
+  std::string body;
+  const bool success = base::ReadFileToString(download_path, &body);
+
+  result.persisted = success && !body_path.empty() &&
+      base::ReplaceFile(download_path, body_path, nullptr);
+  if (!result.persisted) {
+    base::DeleteFile(download_path, false);
+
+    // A previous body must not be returned for a later revalidation
+    if (!body_path.empty()) {
+      base::DeleteFile(body_path, false);
+    }
+  }
+
+  if (success) {
+    result.body = std::move(body);
+  }
+
+  return result;
+}
+
+RewardsURLCache::RewardsURLCache(
+    const base::FilePath& path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner)
+    : path_(path),
+      file_task_runner_(file_task_runner),
+      writer_(path.AppendASCII(kIndexFile), file_task_runner),
+      max_body_size_(kMaxBodySize) {
+}
+
+RewardsURLCache::~RewardsURLCache() {
+  if (writer_.HasPendingWrite()) {
+    writer_.DoScheduledWrite();
+  }
+}
+
+void RewardsURLCache::Load(base::OnceClosure callback) {
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(),
+      FROM_HERE,
+      base::BindOnce(&LoadIndexOnFileTaskRunner, path_),
+      base::BindOnce(&RewardsURLCache::OnLoaded,
+          weak_factory_.GetWeakPtr(),
+          std::move(callback)));
+}
+
+void RewardsURLCache::AllowCaching(const std::string& path) {
+  paths_.insert(path);
+}
+
+bool RewardsURLCache::IsCacheable(
+    const network::ResourceRequest& request) const {
+  if (request.method != net::HttpRequestHeaders::kGetMethod) {
+    return false;
+  }
+
+  // The caller revalidates on its own and has to see 304 Not Modified
+  if (request.headers.HasHeader(net::HttpRequestHeaders::kIfNoneMatch) ||
+      request.headers.HasHeader(net::HttpRequestHeaders::kIfModifiedSince)) {
+    return false;
+  }
+
+  return paths_.find(request.url.path()) != paths_.end();
+}
+
+void RewardsURLCache::Fetch(
+    std::unique_ptr<network::ResourceRequest> request,
+    network::mojom::URLLoaderFactory* url_loader_factory,
+    const net::NetworkTrafficAnnotationTag& traffic_annotation,
+    FetchCallback callback) {
+  DCHECK(request);
+  DCHECK(url_loader_factory);
+
+  const std::string url = request->url.spec();
+
+  // Revalidation is done here, so responses must not be answered by the HTTP
+  // cache of the network service
+  request->load_flags |= net::LOAD_DISABLE_CACHE;
+
+  auto entry = entries_.find(url);
+  if (entry != entries_.end()) {
+    if (!entry->second.etag.empty()) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch,
+          entry->second.etag);
+    }
+
+    if (!entry->second.last_modified.empty()) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+          entry->second.last_modified);
+    }
+  }
+
+  auto loader = network::SimpleURLLoader::Create(std::move(request),
+      traffic_annotation);
+  loader->SetAllowHttpErrorResults(true);
+  loader->SetRetryOptions(kRetriesCountOnNetworkChange,
+      network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
+
+  auto it = url_loaders_.insert(url_loaders_.end(), std::move(loader));
+  (*it)->DownloadToFile(
+      url_loader_factory,
+      base::BindOnce(&RewardsURLCache::OnDownloaded,
+          base::Unretained(this),
+          it,
+          url,
+          std::move(callback)),
+      GetDownloadPath(url),
+      max_body_size_);
+}
+
+void RewardsURLCache::Clear() {
+  entries_.clear();
+  bytes_saved_ = 0;
+  not_modified_count_ = 0;
+}
+
+uint64_t RewardsURLCache::bytes_saved() const {
+  return bytes_saved_;
+}
+
+uint64_t RewardsURLCache::not_modified_count() const {
+  return not_modified_count_;
+}
+
+void RewardsURLCache::set_max_body_size_for_testing(
+    const int64_t max_body_size) {
+  max_body_size_ = max_body_size;
+}
+
+bool RewardsURLCache::SerializeData(std::string* output) {
+  DCHECK(output);
+
+  base::Value entries(base::Value::Type::DICTIONARY);
+  for (const auto& entry : entries_) {
+    base::Value headers(base::Value::Type::DICTIONARY);
+    for (const auto& header : entry.second.headers) {
+      headers.SetStringKey(header.first, header.second);
+    }
+
+    base::Value dictionary(base::Value::Type::DICTIONARY);
+    dictionary.SetStringKey(kETagKey, entry.second.etag);
+    dictionary.SetStringKey(kLastModifiedKey, entry.second.last_modified);
+    dictionary.SetKey(kHeadersKey, std::move(headers));
+
+    entries.SetKey(entry.first, std::move(dictionary));
+  }
+
+  base::Value index(base::Value::Type::DICTIONARY);
+  index.SetStringKey(kBytesSavedKey, base::NumberToString(bytes_saved_));
+  index.SetKey(kEntriesKey, std::move(entries));
+
+  return base::JSONWriter::Write(index, output);
+}
+
+void RewardsURLCache::OnLoaded(
+    base::OnceClosure callback,
+    base::Value index) {
+  const std::string* bytes_saved = index.FindStringKey(kBytesSavedKey);
+  uint64_t bytes_saved_value = 0;
+  if (bytes_saved && base::StringToUint64(*bytes_saved, &bytes_saved_value)) {
+    bytes_saved_ += bytes_saved_value;
+  }
+
+  const base::Value* entries = index.FindDictKey(kEntriesKey);
+  if (entries) {
+    for (const auto& item : entries->DictItems()) {
+      if (!item.second.is_dict()) {
+        continue;
+      }
+
+      Entry entry;
+
+      const std::string* etag = item.second.FindStringKey(kETagKey);
+      if (etag) {
+        entry.etag = *etag;
+      }
+
+      const std::string* last_modified =
+          item.second.FindStringKey(kLastModifiedKey);
+      if (last_modified) {
+        entry.last_modified = *last_modified;
+      }
+
+      const base::Value* headers = item.second.FindDictKey(kHeadersKey);
+      if (headers) {
+        for (const auto& header : headers->DictItems()) {
+          if (header.second.is_string()) {
+            entry.headers[header.first] = header.second.GetString();
+          }
+        }
+      }
+
+      if (entry.etag.empty() && entry.last_modified.empty()) {
+        continue;
+      }
+
+      // Responses which were received while loading are more recent
+      entries_.emplace(item.first, entry);
+    }
+  }
+
+  std::move(callback).Run();
+}
+
+void RewardsURLCache::OnDownloaded(
+    URLLoaderList::iterator it,
+    const std::string& url,
+    FetchCallback callback,
+    base::FilePath file_path) {
+  std::unique_ptr<network::SimpleURLLoader> loader = std::move(*it);
+  url_loaders_.erase(it);
+
+  int response_code = -1;
+  if (loader->ResponseInfo() && loader->ResponseInfo()->headers) {
+    response_code = loader->ResponseInfo()->headers->response_code();
+  }
+
+  const std::map<std::string, std::string> headers =
+      GetResponseHeaders(loader.get());
+
+  if (file_path.empty()) {
+    // The download failed or the body was larger than |max_body_size_|
+    LOG(ERROR) << "Failed to download " << url << ": "
+        << net::ErrorToString(loader->NetError());
+    std::move(callback).Run(response_code, "", headers);
+    return;
+  }
+
+  if (response_code == net::HTTP_NOT_MODIFIED &&
+      entries_.find(url) != entries_.end()) {
+    base::PostTaskAndReplyWithResult(
+        file_task_runner_.get(),
+        FROM_HERE,
+        base::BindOnce(&ReadBodyOnFileTaskRunner, GetBodyPath(url), file_path),
+        base::BindOnce(&RewardsURLCache::OnNotModified,
+            weak_factory_.GetWeakPtr(),
+            url,
+            std::move(callback)));
+    return;
+  }
+
+  const auto etag = headers.find("etag");
+  const auto last_modified = headers.find("last-modified");
+  const bool should_cache = response_code == net::HTTP_OK &&
+      (etag != headers.end() || last_modified != headers.end());
+
+  if (should_cache) {
+    Entry& entry = entries_[url];
+    entry.etag = etag != headers.end() ? etag->second : "";
+    entry.last_modified =
+        last_modified != headers.end() ? last_modified->second : "";
+    entry.headers = headers;
+  } else if (response_code == net::HTTP_OK) {
+    entries_.erase(url);
+  }
+
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(),
+      FROM_HERE,
+      base::BindOnce(&ReadDownloadOnFileTaskRunner,
+          file_path,
+          should_cache ? GetBodyPath(url) : base::FilePath()),
+      base::BindOnce(&RewardsURLCache::OnModified,
+          weak_factory_.GetWeakPtr(),
+          url,
+          response_code,
+          headers,
+          std::move(callback)));
+}
+
+void RewardsURLCache::OnNotModified(
+    const std::string& url,
+    FetchCallback callback,
+    base::Optional<std::string> response_body) {
+  auto entry = entries_.find(url);
+  if (!response_body || entry == entries_.end()) {
+    LOG(ERROR) << "Failed to read cached response for " << url;
+    entries_.erase(url);
+    writer_.ScheduleWrite(this);
+
+    std::move(callback).Run(net::HTTP_SERVICE_UNAVAILABLE, "", {});
+    return;
+  }
+
+  bytes_saved_ += response_body->size();
+  not_modified_count_++;
+  writer_.ScheduleWrite(this);
+
+  VLOG(1) << "Revalidated " << url << ", saved " << response_body->size()
+      << " bytes";
+
+  // Ledger only handles successful responses, the cached response is
+  // equivalent to the one which was revalidated
+  std::move(callback).Run(net::HTTP_OK, *response_body, entry->second.headers);
+}
+
+void RewardsURLCache::OnModified(
+    const std::string& url,
+    const int response_code,
+    const std::map<std::string, std::string>& headers,
+    FetchCallback callback,
+    DownloadResult result) {
+  if (!result.body) {
+    LOG(ERROR) << "Failed to read response for " << url;
+    entries_.erase(url);
+  } else if (!result.persisted && response_code == net::HTTP_OK) {
+    // The body file is gone, so the entry can't answer a later 304
+    LOG(ERROR) << "Failed to cache response for " << url;
+    entries_.erase(url);
+  }
+
+  writer_.ScheduleWrite(this);
+
+  std::move(callback).Run(response_code,
+      result.body ? *result.body : std::string(), headers);
+}
+
+base::FilePath RewardsURLCache::GetBodyPath(const std::string& url) const {
+  return path_.AppendASCII(GetBodyFileName(url));
+}
+
+base::FilePath RewardsURLCache::GetDownloadPath(const std::string& url) {
+  return path_.AppendASCII(GetBodyFileName(url) + "." +
+      base::NumberToString(next_download_id_++) + kDownloadExtension);
+}
+
+}  // namespace brave_rewards
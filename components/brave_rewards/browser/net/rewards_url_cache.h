@@ -0,0 +1,157 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_NET_REWARDS_URL_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_NET_REWARDS_URL_CACHE_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/values.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace network {
+class SimpleURLLoader;
+struct ResourceRequest;
+namespace mojom {
+class URLLoaderFactory;
+}  // namespace mojom
+}  // namespace network
+
+namespace brave_rewards {
+
+// Caches the responses of opted-in ledger GET requests on disk. Cached
+// responses are revalidated with If-None-Match / If-Modified-Since, so
+// periodic fetches of unchanged payloads only transfer the response headers.
+// Response bodies are streamed to a file and bounded in size
+class RewardsURLCache : public base::ImportantFileWriter::DataSerializer {
+ public:
+  using FetchCallback = base::OnceCallback<void(
+      const int response_code,
+      const std::string& response_body,
+      const std::map<std::string, std::string>& headers)>;
+
+  RewardsURLCache(
+      const base::FilePath& path,
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner);
+  ~RewardsURLCache() override;
+
+  // Reads the cache index which was persisted in a previous session
+  void Load(base::OnceClosure callback);
+
+  // Opts in GET requests for URLs with |path|, regardless of their query
+  void AllowCaching(const std::string& path);
+
+  // Conditional requests are not cacheable, their caller handles 304
+  bool IsCacheable(const network::ResourceRequest& request) const;
+
+  void Fetch(
+      std::unique_ptr<network::ResourceRequest> request,
+      network::mojom::URLLoaderFactory* url_loader_factory,
+      const net::NetworkTrafficAnnotationTag& traffic_annotation,
+      FetchCallback callback);
+
+  // Forgets all entries, the files are removed by the owner of |path|
+  void Clear();
+
+  uint64_t bytes_saved() const;
+  uint64_t not_modified_count() const;
+
+  void set_max_body_size_for_testing(const int64_t max_body_size);
+
+  // ImportantFileWriter::DataSerializer implementation
+  bool SerializeData(std::string* output) override;
+
+ private:
+  struct Entry {
+    Entry();
+    Entry(const Entry& entry);
+    ~Entry();
+
+    std::string etag;
+    std::string last_modified;
+    std::map<std::string, std::string> headers;
+  };
+
+  struct DownloadResult {
+    DownloadResult();
+    DownloadResult(DownloadResult&& result);
+    DownloadResult& operator=(DownloadResult&& result);
+    ~DownloadResult();
+
+    base::Optional<std::string> body;
+    // Whether |body| was kept as the cached body of the entry
+    bool persisted = false;
+  };
+
+  using URLLoaderList = std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  // Moves the download to |body_path|, an empty |body_path| drops the body
+  static DownloadResult ReadDownloadOnFileTaskRunner(
+      const base::FilePath& download_path,
+      const base::FilePath& body_path);
+
+  void OnLoaded(
+      base::OnceClosure callback,
+      base::Value index);
+
+  void OnDownloaded(
+      URLLoaderList::iterator it,
+      const std::string& url,
+      FetchCallback callback,
+      base::FilePath file_path);
+
+  void OnNotModified(
+      const std::string& url,
+      FetchCallback callback,
+      base::Optional<std::string> response_body);
+
+  void OnModified(
+      const std::string& url,
+      const int response_code,
+      const std::map<std::string, std::string>& headers,
+      FetchCallback callback,
+      DownloadResult result);
+
+  base::FilePath GetBodyPath(const std::string& url) const;
+  base::FilePath GetDownloadPath(const std::string& url);
+
+  const base::FilePath path_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::ImportantFileWriter writer_;
+
+  std::set<std::string> paths_;
+  std::map<std::string, Entry> entries_;
+  URLLoaderList url_loaders_;
+
+  int64_t max_body_size_;
+  uint64_t next_download_id_ = 0;
+  uint64_t bytes_saved_ = 0;
+  uint64_t not_modified_count_ = 0;
+
+  base::WeakPtrFactory<RewardsURLCache> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(RewardsURLCache);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_NET_REWARDS_URL_CACHE_H_
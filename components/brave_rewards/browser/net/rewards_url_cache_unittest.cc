@@ -0,0 +1,308 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/net/rewards_url_cache.h"
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/task_environment.h"
+#include "crypto/sha2.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "net/http/http_util.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsURLCacheTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const char kPublisherListPath[] = "/api/v3/public/channels";
+const char kPublisherListUrl[] =
+    "https://pcdn.brave.com/api/v3/public/channels?page=1";
+
+const char kBody[] = "[[\"brave.com\",\"wallet_connected\",false,\"address\"]]";
+
+}  // namespace
+
+class RewardsURLCacheTest : public ::testing::Test {
+ protected:
+  RewardsURLCacheTest() :
+      file_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock()})) {
+  }
+
+  ~RewardsURLCacheTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    CreateCache();
+
+    // Stand-in for the rewards servers which answers conditional requests
+    // with 304 Not Modified if the validators match
+    test_url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [this](const network::ResourceRequest& request) {
+          OnRequest(request);
+        }));
+  }
+
+  void CreateCache() {
+    url_cache_ = std::make_unique<RewardsURLCache>(
+        temp_dir_.GetPath().AppendASCII("url_cache"), file_task_runner_);
+    url_cache_->AllowCaching(kPublisherListPath);
+
+    base::RunLoop run_loop;
+    url_cache_->Load(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  void RestartCache() {
+    url_cache_.reset();
+    task_environment_.RunUntilIdle();
+
+    CreateCache();
+  }
+
+  void OnRequest(const network::ResourceRequest& request) {
+    requests_++;
+
+    std::string if_none_match;
+    request.headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch,
+        &if_none_match);
+    std::string if_modified_since;
+    request.headers.GetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+        &if_modified_since);
+
+    const bool not_modified =
+        (!etag_.empty() && if_none_match == etag_) ||
+        (!last_modified_.empty() && if_modified_since == last_modified_);
+
+    std::string raw_headers = not_modified
+        ? "HTTP/1.1 304 Not Modified\n"
+        : "HTTP/1.1 200 OK\n";
+    if (!etag_.empty()) {
+      raw_headers += "ETag: " + etag_ + "\n";
+    }
+    if (!last_modified_.empty()) {
+      raw_headers += "Last-Modified: " + last_modified_ + "\n";
+    }
+
+    const std::string body = not_modified ? "" : body_;
+    bytes_sent_ += body.size();
+
+    auto head = network::mojom::URLResponseHead::New();
+    head->headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+        net::HttpUtil::AssembleRawHeaders(raw_headers));
+
+    network::URLLoaderCompletionStatus status(net::OK);
+    status.decoded_body_length = body.size();
+    test_url_loader_factory_.AddResponse(request.url, std::move(head), body,
+        status);
+  }
+
+  int Fetch(
+      const std::string& url,
+      std::string* response_body) {
+    auto request = std::make_unique<network::ResourceRequest>();
+    request->url = GURL(url);
+    request->method = net::HttpRequestHeaders::kGetMethod;
+
+    int response_code = -1;
+    base::RunLoop run_loop;
+    url_cache_->Fetch(std::move(request), &test_url_loader_factory_,
+        TRAFFIC_ANNOTATION_FOR_TESTS,
+        base::BindLambdaForTesting([&](
+            const int code,
+            const std::string& body,
+            const std::map<std::string, std::string>& headers) {
+          response_code = code;
+          *response_body = body;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+
+    return response_code;
+  }
+
+  base::FilePath GetBodyPath(const std::string& url) const {
+    return temp_dir_.GetPath().AppendASCII("url_cache").AppendASCII(
+        base::ToLowerASCII(base::HexEncode(
+            crypto::SHA256HashString(url).data(), crypto::kSHA256Length)));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::ScopedTempDir temp_dir_;
+  network::TestURLLoaderFactory test_url_loader_factory_;
+  std::unique_ptr<RewardsURLCache> url_cache_;
+
+  std::string body_ = kBody;
+  std::string etag_;
+  std::string last_modified_;
+  int requests_ = 0;
+  size_t bytes_sent_ = 0;
+};
+
+TEST_F(RewardsURLCacheTest, IsCacheable) {
+  network::ResourceRequest request;
+  request.url = GURL(kPublisherListUrl);
+  request.method = net::HttpRequestHeaders::kGetMethod;
+  EXPECT_TRUE(url_cache_->IsCacheable(request));
+
+  request.method = net::HttpRequestHeaders::kPostMethod;
+  EXPECT_FALSE(url_cache_->IsCacheable(request));
+
+  request.url = GURL("https://pcdn.brave.com/api/v3/public/channels/1");
+  request.method = net::HttpRequestHeaders::kGetMethod;
+  EXPECT_FALSE(url_cache_->IsCacheable(request));
+}
+
+TEST_F(RewardsURLCacheTest, ConditionalRequestsAreNotCacheable) {
+  network::ResourceRequest request;
+  request.url = GURL(kPublisherListUrl);
+  request.method = net::HttpRequestHeaders::kGetMethod;
+  request.headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch, "\"1\"");
+  EXPECT_FALSE(url_cache_->IsCacheable(request));
+
+  request.headers.Clear();
+  request.headers.SetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+      "Wed, 21 Oct 2015 07:28:00 GMT");
+  EXPECT_FALSE(url_cache_->IsCacheable(request));
+}
+
+TEST_F(RewardsURLCacheTest, RevalidatesWithETag) {
+  etag_ = "\"1\"";
+
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  body.clear();
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  EXPECT_EQ(2, requests_);
+  EXPECT_EQ(strlen(kBody), bytes_sent_);
+  EXPECT_EQ(strlen(kBody), url_cache_->bytes_saved());
+  EXPECT_EQ(1u, url_cache_->not_modified_count());
+}
+
+TEST_F(RewardsURLCacheTest, RevalidatesWithLastModified) {
+  last_modified_ = "Wed, 01 Apr 2020 00:00:00 GMT";
+
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+
+  body.clear();
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  EXPECT_EQ(strlen(kBody), bytes_sent_);
+  EXPECT_EQ(1u, url_cache_->not_modified_count());
+}
+
+TEST_F(RewardsURLCacheTest, ReplacesModifiedResponse) {
+  etag_ = "\"1\"";
+
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+
+  etag_ = "\"2\"";
+  body_ = "[]";
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ("[]", body);
+
+  body.clear();
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ("[]", body);
+
+  EXPECT_EQ(strlen(kBody) + 2, bytes_sent_);
+  EXPECT_EQ(2u, url_cache_->bytes_saved());
+}
+
+TEST_F(RewardsURLCacheTest, DoesNotRevalidateWithoutValidators) {
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  EXPECT_EQ(2 * strlen(kBody), bytes_sent_);
+  EXPECT_EQ(0u, url_cache_->bytes_saved());
+}
+
+TEST_F(RewardsURLCacheTest, PersistsAcrossSessions) {
+  etag_ = "\"1\"";
+
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+
+  RestartCache();
+
+  body.clear();
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  EXPECT_EQ(strlen(kBody), bytes_sent_);
+  EXPECT_EQ(2 * strlen(kBody), url_cache_->bytes_saved());
+}
+
+TEST_F(RewardsURLCacheTest, FailsIfBodyExceedsMaxSize) {
+  etag_ = "\"1\"";
+  url_cache_->set_max_body_size_for_testing(strlen(kBody) - 1);
+
+  std::string body = "not empty";
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_TRUE(body.empty());
+
+  // The truncated response must not be cached
+  url_cache_->set_max_body_size_for_testing(strlen(kBody));
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+  EXPECT_EQ(0u, url_cache_->not_modified_count());
+}
+
+TEST_F(RewardsURLCacheTest, DropsEntryIfBodyIsNotPersisted) {
+  etag_ = "\"1\"";
+
+  // A non-empty directory in place of the body file fails the move of the
+  // download
+  const base::FilePath body_path = GetBodyPath(kPublisherListUrl);
+  ASSERT_TRUE(base::CreateDirectory(body_path));
+  ASSERT_EQ(0, base::WriteFile(body_path.AppendASCII("file"), "", 0));
+
+  std::string body;
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  // Without a body the entry is not revalidated, so the response is fetched
+  // in full instead of failing on 304 Not Modified
+  body.clear();
+  EXPECT_EQ(net::HTTP_OK, Fetch(kPublisherListUrl, &body));
+  EXPECT_EQ(kBody, body);
+
+  EXPECT_EQ(2, requests_);
+  EXPECT_EQ(2 * strlen(kBody), bytes_sent_);
+  EXPECT_EQ(0u, url_cache_->not_modified_count());
+}
+
+}  // namespace brave_rewards
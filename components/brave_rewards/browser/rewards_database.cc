@@ -18,6 +18,10 @@ namespace brave_rewards {
 
 namespace {
 
+// The ledger issues a few dozen distinct statements, so this is large enough
+// to keep all of them prepared
+const size_t kStatementCacheSize = 64;
+
 void HandleBinding(
     sql::Statement* statement,
     const ledger::DBCommandBinding& binding) {
@@ -56,6 +60,67 @@ void HandleBinding(
   }
 }
 
+size_t GetColumnSize(
+    const ledger::DBColumnValues& values) {
+  switch (values.which()) {
+    case ledger::DBColumnValues::Tag::INT_VALUES: {
+      return values.get_int_values().size();
+    }
+    case ledger::DBColumnValues::Tag::INT64_VALUES: {
+      return values.get_int64_values().size();
+    }
+    case ledger::DBColumnValues::Tag::DOUBLE_VALUES: {
+      return values.get_double_values().size();
+    }
+    case ledger::DBColumnValues::Tag::BOOL_VALUES: {
+      return values.get_bool_values().size();
+    }
+    case ledger::DBColumnValues::Tag::STRING_VALUES: {
+      return values.get_string_values().size();
+    }
+    default: {
+      NOTREACHED();
+      return 0;
+    }
+  }
+}
+
+void HandleColumnBinding(
+    sql::Statement* statement,
+    const ledger::DBColumnBinding& binding,
+    const size_t row) {
+  if (!statement) {
+    return;
+  }
+
+  const auto& values = *binding.values;
+  switch (values.which()) {
+    case ledger::DBColumnValues::Tag::INT_VALUES: {
+      statement->BindInt(binding.index, values.get_int_values()[row]);
+      return;
+    }
+    case ledger::DBColumnValues::Tag::INT64_VALUES: {
+      statement->BindInt64(binding.index, values.get_int64_values()[row]);
+      return;
+    }
+    case ledger::DBColumnValues::Tag::DOUBLE_VALUES: {
+      statement->BindDouble(binding.index, values.get_double_values()[row]);
+      return;
+    }
+    case ledger::DBColumnValues::Tag::BOOL_VALUES: {
+      statement->BindBool(binding.index, values.get_bool_values()[row]);
+      return;
+    }
+    case ledger::DBColumnValues::Tag::STRING_VALUES: {
+      statement->BindString(binding.index, values.get_string_values()[row]);
+      return;
+    }
+    default: {
+      NOTREACHED();
+    }
+  }
+}
+
 ledger::DBRecordPtr CreateRecord(
     sql::Statement* statement,
     const std::vector<ledger::DBCommand::RecordBindingType>& bindings) {
@@ -104,7 +169,10 @@ ledger::DBRecordPtr CreateRecord(
 
 RewardsDatabase::RewardsDatabase(const base::FilePath& db_path) :
     db_path_(db_path),
-    initialized_(false) {
+    initialized_(false),
+    statement_cache_(kStatementCacheSize),
+    statement_cache_hits_(0),
+    statement_cache_misses_(0) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -155,6 +223,10 @@ void RewardsDatabase::RunTransaction(
         status = Run(command.get());
         break;
       }
+      case ledger::DBCommand::Type::RUN_BULK: {
+        status = RunBulk(command.get());
+        break;
+      }
       case ledger::DBCommand::Type::MIGRATE: {
         status = Migrate(
             transaction->version,
@@ -250,7 +322,7 @@ ledger::DBCommandResponse::Status RewardsDatabase::Run(
     return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
   }
 
-  sql::Statement statement(db_.GetUniqueStatement(command->command.c_str()));
+  sql::Statement statement(GetStatement(*command));
 
   for (auto const& binding : command->bindings) {
     HandleBinding(&statement, *binding.get());
@@ -279,8 +351,7 @@ ledger::DBCommandResponse::Status RewardsDatabase::Read(
     return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
   }
 
-  sql::Statement statement(
-      db_.GetUniqueStatement(command->command.c_str()));
+  sql::Statement statement(GetStatement(*command));
 
   for (auto const& binding : command->bindings) {
     HandleBinding(&statement, *binding.get());
@@ -297,6 +368,79 @@ ledger::DBCommandResponse::Status RewardsDatabase::Read(
   return ledger::DBCommandResponse::Status::RESPONSE_OK;
 }
 
+ledger::DBCommandResponse::Status RewardsDatabase::RunBulk(
+    ledger::DBCommand* command) {
+  if (!initialized_) {
+    return ledger::DBCommandResponse::Status::INITIALIZATION_ERROR;
+  }
+
+  if (!command || command->column_bindings.empty()) {
+    return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
+  }
+
+  const size_t rows = GetColumnSize(*command->column_bindings[0]->values);
+  for (const auto& binding : command->column_bindings) {
+    if (GetColumnSize(*binding->values) != rows) {
+      return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
+    }
+  }
+
+  sql::Statement statement(GetStatement(*command));
+
+  for (size_t row = 0; row < rows; row++) {
+    for (const auto& binding : command->bindings) {
+      HandleBinding(&statement, *binding.get());
+    }
+
+    for (const auto& binding : command->column_bindings) {
+      HandleColumnBinding(&statement, *binding, row);
+    }
+
+    if (!statement.Run()) {
+      LOG(ERROR) <<
+          "DB Run bulk error: " <<
+          db_.GetErrorMessage() <<
+          " (" << db_.GetErrorCode() << ")";
+
+      return ledger::DBCommandResponse::Status::COMMAND_ERROR;
+    }
+
+    statement.Reset(true);
+  }
+
+  return ledger::DBCommandResponse::Status::RESPONSE_OK;
+}
+
+scoped_refptr<sql::Database::StatementRef> RewardsDatabase::GetStatement(
+    const ledger::DBCommand& command) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!command.cache_statement) {
+    return db_.GetUniqueStatement(command.command.c_str());
+  }
+
+  const std::string& sql = command.command;
+  auto iter = statement_cache_.Get(sql);
+  if (iter != statement_cache_.end()) {
+    if (iter->second->is_valid()) {
+      statement_cache_hits_++;
+      return iter->second;
+    }
+
+    statement_cache_.Erase(iter);
+  }
+
+  statement_cache_misses_++;
+
+  scoped_refptr<sql::Database::StatementRef> statement =
+      db_.GetUniqueStatement(sql.c_str());
+  if (statement->is_valid()) {
+    statement_cache_.Put(sql, statement);
+  }
+
+  return statement;
+}
+
 ledger::DBCommandResponse::Status RewardsDatabase::Migrate(
     const int32_t version,
     const int32_t compatible_version) {
@@ -313,6 +457,7 @@ ledger::DBCommandResponse::Status RewardsDatabase::Migrate(
 void RewardsDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  statement_cache_.Clear();
   db_.TrimMemory();
 }
 
@@ -6,9 +6,13 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_DATABASE_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_DATABASE_H_
 
+#include <stddef.h>
+
 #include <memory>
+#include <string>
 
 #include "base/compiler_specific.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/sequence_checker.h"
@@ -29,6 +33,9 @@ class RewardsDatabase {
       ledger::DBTransactionPtr transaction,
       ledger::DBCommandResponse* response);
 
+  size_t statement_cache_hits() const { return statement_cache_hits_; }
+  size_t statement_cache_misses() const { return statement_cache_misses_; }
+
  private:
   ledger::DBCommandResponse::Status Initialize(
       const int32_t version,
@@ -43,6 +50,15 @@ class RewardsDatabase {
       ledger::DBCommand* command,
       ledger::DBCommandResponse* response);
 
+  ledger::DBCommandResponse::Status RunBulk(ledger::DBCommand* command);
+
+  // Returns a prepared statement for |command|. Commands marked with
+  // |cache_statement| reuse a previously prepared statement with the same SQL
+  // if one is cached, their bindings are cleared when the returned statement
+  // goes out of scope
+  scoped_refptr<sql::Database::StatementRef> GetStatement(
+      const ledger::DBCommand& command);
+
   ledger::DBCommandResponse::Status Migrate(
       const int32_t version,
       const int32_t compatible_version);
@@ -55,6 +71,11 @@ class RewardsDatabase {
   sql::MetaTable meta_table_;
   bool initialized_;
 
+  base::MRUCache<std::string, scoped_refptr<sql::Database::StatementRef>>
+      statement_cache_;
+  size_t statement_cache_hits_;
+  size_t statement_cache_misses_;
+
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -0,0 +1,445 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_database.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "bat/ledger/internal/database/database_activity_info.h"
+#include "bat/ledger/internal/database/database_initialize.h"
+#include "bat/ledger/internal/database/database_publisher_info.h"
+#include "bat/ledger/internal/ledger_client_mock.h"
+#include "bat/ledger/internal/ledger_impl_mock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsDatabase*
+
+using ::testing::_;
+using ::testing::Invoke;
+
+namespace brave_rewards {
+
+namespace {
+
+const char kInsertSql[] = "INSERT INTO test_table (id, name) VALUES (?, ?)";
+
+const char kSelectSql[] = "SELECT id, name FROM test_table WHERE id >= ?";
+
+ledger::DBCommandPtr BuildCommand(
+    const ledger::DBCommand::Type type,
+    const std::string& sql) {
+  auto command = ledger::DBCommand::New();
+  command->type = type;
+  command->command = sql;
+  return command;
+}
+
+void BindInt(
+    ledger::DBCommand* command,
+    const int index,
+    const int32_t value) {
+  auto binding = ledger::DBCommandBinding::New();
+  binding->index = index;
+  binding->value = ledger::DBValue::New();
+  binding->value->set_int_value(value);
+  command->bindings.push_back(std::move(binding));
+}
+
+void BindString(
+    ledger::DBCommand* command,
+    const int index,
+    const std::string& value) {
+  auto binding = ledger::DBCommandBinding::New();
+  binding->index = index;
+  binding->value = ledger::DBValue::New();
+  binding->value->set_string_value(value);
+  command->bindings.push_back(std::move(binding));
+}
+
+void BindIntColumn(
+    ledger::DBCommand* command,
+    const int index,
+    std::vector<int32_t> values) {
+  auto binding = ledger::DBColumnBinding::New();
+  binding->index = index;
+  binding->values = ledger::DBColumnValues::New();
+  binding->values->set_int_values(std::move(values));
+  command->column_bindings.push_back(std::move(binding));
+}
+
+void BindStringColumn(
+    ledger::DBCommand* command,
+    const int index,
+    std::vector<std::string> values) {
+  auto binding = ledger::DBColumnBinding::New();
+  binding->index = index;
+  binding->values = ledger::DBColumnValues::New();
+  binding->values->set_string_values(std::move(values));
+  command->column_bindings.push_back(std::move(binding));
+}
+
+}  // namespace
+
+class RewardsDatabaseTest : public ::testing::Test {
+ protected:
+  RewardsDatabaseTest() = default;
+
+  ~RewardsDatabaseTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<RewardsDatabase>(
+        temp_dir_.GetPath().AppendASCII("rewards.db"));
+
+    auto transaction = ledger::DBTransaction::New();
+    transaction->version = 1;
+    transaction->compatible_version = 1;
+    transaction->commands.push_back(
+        BuildCommand(ledger::DBCommand::Type::INITIALIZE, ""));
+    transaction->commands.push_back(
+        BuildCommand(ledger::DBCommand::Type::EXECUTE,
+            "CREATE TABLE test_table (id INTEGER NOT NULL, name TEXT)"));
+
+    ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+        RunTransaction(std::move(transaction), nullptr));
+  }
+
+  ledger::DBCommandResponse::Status RunTransaction(
+      ledger::DBTransactionPtr transaction,
+      ledger::DBCommandResponsePtr* response) {
+    auto command_response = ledger::DBCommandResponse::New();
+    command_response->status =
+        ledger::DBCommandResponse::Status::RESPONSE_OK;
+    database_->RunTransaction(std::move(transaction), command_response.get());
+
+    const auto status = command_response->status;
+    if (response) {
+      *response = std::move(command_response);
+    }
+
+    return status;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<RewardsDatabase> database_;
+};
+
+TEST_F(RewardsDatabaseTest, ReusesPreparedStatements) {
+  // Arrange
+  auto transaction = ledger::DBTransaction::New();
+  for (int i = 0; i < 10; i++) {
+    auto command = BuildCommand(ledger::DBCommand::Type::RUN, kInsertSql);
+    command->cache_statement = true;
+    BindInt(command.get(), 0, i);
+    if (i % 2 == 0) {
+      BindString(command.get(), 1, "name_" + std::to_string(i));
+    }
+    transaction->commands.push_back(std::move(command));
+  }
+
+  // Act
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(transaction), nullptr));
+
+  // Assert
+  EXPECT_EQ(1u, database_->statement_cache_misses());
+  EXPECT_EQ(9u, database_->statement_cache_hits());
+}
+
+TEST_F(RewardsDatabaseTest, ClearsBindingsBetweenReusedStatements) {
+  // Arrange
+  auto transaction = ledger::DBTransaction::New();
+  for (int i = 0; i < 4; i++) {
+    auto command = BuildCommand(ledger::DBCommand::Type::RUN, kInsertSql);
+    command->cache_statement = true;
+    BindInt(command.get(), 0, i);
+    if (i % 2 == 0) {
+      BindString(command.get(), 1, "name_" + std::to_string(i));
+    }
+    transaction->commands.push_back(std::move(command));
+  }
+
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(transaction), nullptr));
+
+  // Act
+  ledger::DBCommandResponsePtr response;
+  for (int i = 0; i < 2; i++) {
+    auto read_transaction = ledger::DBTransaction::New();
+    auto command = BuildCommand(ledger::DBCommand::Type::READ, kSelectSql);
+    command->cache_statement = true;
+    BindInt(command.get(), 0, 0);
+    command->record_bindings = {
+      ledger::DBCommand::RecordBindingType::INT_TYPE,
+      ledger::DBCommand::RecordBindingType::STRING_TYPE
+    };
+    read_transaction->commands.push_back(std::move(command));
+
+    ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+        RunTransaction(std::move(read_transaction), &response));
+  }
+
+  // Assert
+  ASSERT_TRUE(response->result);
+  const auto& records = response->result->get_records();
+  ASSERT_EQ(4u, records.size());
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(i, records[i]->fields[0]->get_int_value());
+
+    // Rows inserted without a name binding must not inherit the name bound
+    // for the previous row
+    const std::string expected_name =
+        i % 2 == 0 ? "name_" + std::to_string(i) : "";
+    EXPECT_EQ(expected_name, records[i]->fields[1]->get_string_value());
+  }
+
+  EXPECT_EQ(2u, database_->statement_cache_misses());
+  EXPECT_EQ(4u, database_->statement_cache_hits());
+}
+
+TEST_F(RewardsDatabaseTest, DoesNotCacheUnmarkedStatements) {
+  // Arrange
+  auto transaction = ledger::DBTransaction::New();
+  for (int i = 0; i < 5; i++) {
+    // SQL with values pasted in is never the same text twice, so it must not
+    // take up cache entries
+    transaction->commands.push_back(BuildCommand(
+        ledger::DBCommand::Type::RUN,
+        "INSERT INTO test_table (id, name) VALUES (" +
+            std::to_string(i) + ", 'name')"));
+  }
+
+  auto command = BuildCommand(ledger::DBCommand::Type::RUN, kInsertSql);
+  BindInt(command.get(), 0, 5);
+  transaction->commands.push_back(std::move(command));
+
+  // Act
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(transaction), nullptr));
+
+  // Assert
+  EXPECT_EQ(0u, database_->statement_cache_misses());
+  EXPECT_EQ(0u, database_->statement_cache_hits());
+}
+
+TEST_F(RewardsDatabaseTest, RunBulkInsertsEveryRow) {
+  // Arrange
+  const int32_t count = 500000;
+
+  std::vector<int32_t> ids;
+  std::vector<std::string> names;
+  for (int32_t i = 0; i < count; i++) {
+    ids.push_back(i);
+    names.push_back("publisher_\"'" + std::to_string(i) + ".com");
+  }
+
+  auto transaction = ledger::DBTransaction::New();
+  auto command = BuildCommand(ledger::DBCommand::Type::RUN_BULK, kInsertSql);
+  BindIntColumn(command.get(), 0, std::move(ids));
+  BindStringColumn(command.get(), 1, std::move(names));
+  transaction->commands.push_back(std::move(command));
+
+  // Act
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(transaction), nullptr));
+
+  // Assert
+  auto read_transaction = ledger::DBTransaction::New();
+  auto read_command = BuildCommand(ledger::DBCommand::Type::READ,
+      "SELECT COUNT(*), MAX(id), MAX(name) FROM test_table");
+  read_command->record_bindings = {
+    ledger::DBCommand::RecordBindingType::INT_TYPE,
+    ledger::DBCommand::RecordBindingType::INT_TYPE,
+    ledger::DBCommand::RecordBindingType::STRING_TYPE
+  };
+  read_transaction->commands.push_back(std::move(read_command));
+
+  ledger::DBCommandResponsePtr response;
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(read_transaction), &response));
+
+  ASSERT_TRUE(response->result);
+  const auto& records = response->result->get_records();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(count, records[0]->fields[0]->get_int_value());
+  EXPECT_EQ(count - 1, records[0]->fields[1]->get_int_value());
+  EXPECT_EQ("publisher_\"'99999.com",
+      records[0]->fields[2]->get_string_value());
+}
+
+TEST_F(RewardsDatabaseTest, RunBulkBindsValuesForEveryRow) {
+  // Arrange
+  auto transaction = ledger::DBTransaction::New();
+  auto command = BuildCommand(ledger::DBCommand::Type::RUN_BULK, kInsertSql);
+  BindIntColumn(command.get(), 0, {1, 2, 3});
+  BindString(command.get(), 1, "shared");
+  transaction->commands.push_back(std::move(command));
+
+  // Act
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(transaction), nullptr));
+
+  // Assert
+  auto read_transaction = ledger::DBTransaction::New();
+  auto read_command = BuildCommand(ledger::DBCommand::Type::READ,
+      "SELECT COUNT(*) FROM test_table WHERE name = 'shared'");
+  read_command->record_bindings = {
+    ledger::DBCommand::RecordBindingType::INT_TYPE
+  };
+  read_transaction->commands.push_back(std::move(read_command));
+
+  ledger::DBCommandResponsePtr response;
+  ASSERT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK,
+      RunTransaction(std::move(read_transaction), &response));
+
+  ASSERT_TRUE(response->result);
+  const auto& records = response->result->get_records();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(3, records[0]->fields[0]->get_int_value());
+}
+
+TEST_F(RewardsDatabaseTest, RunBulkFailsForMismatchedColumns) {
+  // Arrange
+  auto transaction = ledger::DBTransaction::New();
+  auto command = BuildCommand(ledger::DBCommand::Type::RUN_BULK, kInsertSql);
+  BindIntColumn(command.get(), 0, {1, 2, 3});
+  BindStringColumn(command.get(), 1, {"one", "two"});
+  transaction->commands.push_back(std::move(command));
+
+  // Act
+  const auto status = RunTransaction(std::move(transaction), nullptr);
+
+  // Assert
+  EXPECT_EQ(ledger::DBCommandResponse::Status::RESPONSE_ERROR, status);
+}
+
+// Runs the ledger's own database code against a real database, so the
+// statements it marks for caching are checked through the cached path
+class RewardsDatabaseLedgerTest : public ::testing::Test {
+ protected:
+  RewardsDatabaseLedgerTest() = default;
+
+  ~RewardsDatabaseLedgerTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<RewardsDatabase>(
+        temp_dir_.GetPath().AppendASCII("rewards.db"));
+
+    mock_ledger_client_ = std::make_unique<ledger::MockLedgerClient>();
+    mock_ledger_impl_ = std::make_unique<bat_ledger::MockLedgerImpl>(
+        mock_ledger_client_.get());
+    ON_CALL(*mock_ledger_impl_, RunDBTransaction(_, _))
+        .WillByDefault(
+          Invoke([this](
+              ledger::DBTransactionPtr transaction,
+              ledger::RunDBTransactionCallback callback) {
+            auto response = ledger::DBCommandResponse::New();
+            response->status = ledger::DBCommandResponse::Status::RESPONSE_OK;
+            database_->RunTransaction(std::move(transaction), response.get());
+            callback(std::move(response));
+          }));
+
+    braveledger_database::DatabaseInitialize initialize(
+        mock_ledger_impl_.get());
+    ledger::Result result = ledger::Result::LEDGER_ERROR;
+    initialize.Start(false, [&result](const ledger::Result initialize_result) {
+      result = initialize_result;
+    });
+    ASSERT_EQ(ledger::Result::LEDGER_OK, result);
+  }
+
+  ledger::PublisherInfoPtr CreatePublisherInfo(
+      const std::string& id,
+      const uint64_t duration) {
+    auto info = ledger::PublisherInfo::New();
+    info->id = id;
+    info->name = id;
+    info->url = "https://" + id;
+    info->duration = duration;
+    info->score = 1.0;
+    info->percent = 10;
+    info->visits = 1;
+    return info;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<RewardsDatabase> database_;
+  std::unique_ptr<ledger::MockLedgerClient> mock_ledger_client_;
+  std::unique_ptr<bat_ledger::MockLedgerImpl> mock_ledger_impl_;
+};
+
+TEST_F(RewardsDatabaseLedgerTest, ReusesStatementsForActivityInfo) {
+  // Arrange
+  const std::vector<std::string> ids = {
+    "brave.com",
+    "example.com",
+    "example.org"
+  };
+
+  braveledger_database::DatabasePublisherInfo publisher_info(
+      mock_ledger_impl_.get());
+  for (const auto& id : ids) {
+    ledger::Result result = ledger::Result::LEDGER_ERROR;
+    publisher_info.InsertOrUpdate(CreatePublisherInfo(id, 0),
+        [&result](const ledger::Result insert_result) {
+          result = insert_result;
+        });
+    ASSERT_EQ(ledger::Result::LEDGER_OK, result);
+  }
+
+  // The schema is created and migrated with statements that are only run
+  // once, so only the inserts above may have gone through the cache
+  const size_t misses = database_->statement_cache_misses();
+  const size_t hits = database_->statement_cache_hits();
+  EXPECT_EQ(1u, misses);
+  EXPECT_EQ(ids.size() - 1, hits);
+
+  braveledger_database::DatabaseActivityInfo activity_info(
+      mock_ledger_impl_.get());
+
+  // Act
+  for (uint64_t duration = 10; duration <= 20; duration += 10) {
+    ledger::PublisherInfoList list;
+    for (const auto& id : ids) {
+      list.push_back(CreatePublisherInfo(id, duration));
+    }
+
+    ledger::Result result = ledger::Result::LEDGER_ERROR;
+    activity_info.InsertOrUpdateList(std::move(list),
+        [&result](const ledger::Result insert_result) {
+          result = insert_result;
+        });
+    ASSERT_EQ(ledger::Result::LEDGER_OK, result);
+  }
+
+  auto filter = ledger::ActivityInfoFilter::New();
+  filter->excluded = ledger::ExcludeFilter::FILTER_ALL;
+  ledger::PublisherInfoList records;
+  activity_info.GetRecordsList(0, 0, std::move(filter),
+      [&records](ledger::PublisherInfoList list) {
+        records = std::move(list);
+      });
+
+  // Assert
+  ASSERT_EQ(ids.size(), records.size());
+  for (const auto& record : records) {
+    EXPECT_EQ(20u, record->duration) << record->id;
+  }
+
+  // The activity list is read with filters pasted into its SQL, so only the
+  // activity inserts add to the cache
+  EXPECT_EQ(misses + 1, database_->statement_cache_misses());
+  EXPECT_EQ(hits + 2 * ids.size() - 1, database_->statement_cache_hits());
+}
+
+}  // namespace brave_rewards
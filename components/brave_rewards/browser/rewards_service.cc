@@ -59,6 +59,7 @@ void RewardsService::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   registry->RegisterBooleanPref(prefs::kBraveRewardsEnabledMigrated, false);
   registry->RegisterDictionaryPref(prefs::kRewardsExternalWallets);
   registry->RegisterUint64Pref(prefs::kStateServerPublisherListStamp, 0ull);
+  registry->RegisterStringPref(prefs::kStateServerPublisherListETags, "");
   registry->RegisterStringPref(prefs::kStateUpholdAnonAddress, "");
   registry->RegisterStringPref(prefs::kRewardsBadgeText, "1");
 #if defined(OS_ANDROID)
@@ -47,6 +47,7 @@
 #include "brave/components/brave_rewards/browser/auto_contribution_props.h"
 #include "brave/components/brave_rewards/browser/balance_report.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
+#include "brave/components/brave_rewards/browser/net/rewards_url_cache.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
 #include "brave/components/brave_rewards/browser/rewards_database.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
@@ -54,6 +55,7 @@
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
+#include "brave/components/brave_rewards/browser/rewards_state_writer.h"
 #include "brave/components/brave_rewards/browser/static_values.h"
 #include "brave/components/brave_rewards/browser/switches.h"
 #include "brave/components/brave_rewards/browser/wallet_properties.h"
@@ -102,6 +104,10 @@ namespace brave_rewards {
 
 static const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Changes of the ledger and publisher state within this interval are written
+// to disk at once
+static const int kStateCommitIntervalInSeconds = 2;
+
 class LogStreamImpl : public ledger::LogStream {
  public:
   LogStreamImpl(const char* file,
@@ -217,18 +223,6 @@ std::pair<std::string, base::Value> LoadStateOnFileTaskRunner(
   return result;
 }
 
-// `callback` has a WeakPtr so this won't crash if the file finishes
-// writing after RewardsServiceImpl has been destroyed
-void PostWriteCallback(
-    const base::Callback<void(bool success)>& callback,
-    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
-    bool write_success) {
-  // We can't run |callback| on the current thread. Bounce back to
-  // the |reply_task_runner| which is the correct sequenced thread.
-  reply_task_runner->PostTask(FROM_HERE,
-                              base::Bind(callback, write_success));
-}
-
 time_t GetCurrentTimestamp() {
   return base::Time::NowFromSystemTime().ToTimeT();
 }
@@ -333,14 +327,23 @@ const base::FilePath::StringType kPublisher_state(L"publisher_state");
 const base::FilePath::StringType kPublisher_info_db(L"publisher_info_db");
 const base::FilePath::StringType kPublishers_list(L"publishers_list");
 const base::FilePath::StringType kRewardsStatePath(L"rewards_service");
+const base::FilePath::StringType kURLCachePath(L"url_cache");
 #else
 const base::FilePath::StringType kLedger_state("ledger_state");
 const base::FilePath::StringType kPublisher_state("publisher_state");
 const base::FilePath::StringType kPublisher_info_db("publisher_info_db");
 const base::FilePath::StringType kPublishers_list("publishers_list");
 const base::FilePath::StringType kRewardsStatePath("rewards_service");
+const base::FilePath::StringType kURLCachePath("url_cache");
 #endif
 
+// Paths of ledger GET requests which are repeated periodically, their
+// responses are cached and revalidated. The publisher list is not cached here
+// as ledger revalidates it on its own and skips the update on 304
+const char* const kCacheableURLPaths[] = {
+  "/v1/promotions"
+};
+
 #if BUILDFLAG(ENABLE_GREASELION)
 RewardsServiceImpl::RewardsServiceImpl(
     Profile* profile,
@@ -363,12 +366,28 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
       rewards_base_path_(profile_->GetPath().Append(kRewardsStatePath)),
       rewards_database_(new RewardsDatabase(publisher_info_db_path_)),
+      url_cache_(new RewardsURLCache(
+          rewards_base_path_.Append(kURLCachePath), file_task_runner_)),
+      ledger_state_writer_(new RewardsStateWriter(
+          ledger_state_path_,
+          file_task_runner_,
+          base::TimeDelta::FromSeconds(kStateCommitIntervalInSeconds))),
+      publisher_state_writer_(new RewardsStateWriter(
+          publisher_state_path_,
+          file_task_runner_,
+          base::TimeDelta::FromSeconds(kStateCommitIntervalInSeconds))),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
       next_timer_id_(0),
       reset_states_(false) {
   file_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&EnsureRewardsBaseDirectoryExists,
                                 rewards_base_path_));
+
+  for (const auto* path : kCacheableURLPaths) {
+    url_cache_->AllowCaching(path);
+  }
+  url_cache_->Load(base::DoNothing());
+
   // Set up the rewards data source
   content::URLDataSource::Add(profile_,
                               std::make_unique<BraveRewardsSource>(profile_));
@@ -773,6 +792,9 @@ void RewardsServiceImpl::Shutdown() {
   }
   url_loaders_.clear();
 
+  ledger_state_writer_->Flush();
+  publisher_state_writer_->Flush();
+
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
@@ -910,6 +932,9 @@ void RewardsServiceImpl::OnReconcileComplete(
 
 void RewardsServiceImpl::LoadLedgerState(
     ledger::OnLoadCallback callback) {
+  // Pending state is written first as the file task runner is sequenced
+  ledger_state_writer_->Flush();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadStateOnFileTaskRunner, ledger_state_path_),
       base::BindOnce(&RewardsServiceImpl::OnLedgerStateLoaded,
@@ -955,6 +980,7 @@ void RewardsServiceImpl::LoadPublisherState(
         base::BindOnce(&RewardsServiceImpl::SetRewardsMainEnabledPref,
           AsWeakPtr()));
   }
+  publisher_state_writer_->Flush();
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner, publisher_state_path_),
       base::BindOnce(&RewardsServiceImpl::OnPublisherStateLoaded,
@@ -980,19 +1006,11 @@ void RewardsServiceImpl::SaveLedgerState(
   if (reset_states_) {
     return;
   }
-  base::ImportantFileWriter writer(
-      ledger_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnLedgerStateSaved,
-            AsWeakPtr(),
-            callback),
-        base::SequencedTaskRunnerHandle::Get()));
 
-  writer.WriteNow(std::make_unique<std::string>(ledger_state));
+  ledger_state_writer_->Save(ledger_state,
+      base::BindOnce(&RewardsServiceImpl::OnLedgerStateSaved,
+          AsWeakPtr(),
+          callback));
 }
 
 void RewardsServiceImpl::OnLedgerStateSaved(
@@ -1013,19 +1031,11 @@ void RewardsServiceImpl::SavePublisherState(
   if (reset_states_) {
     return;
   }
-  base::ImportantFileWriter writer(publisher_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(
-            &RewardsServiceImpl::OnPublisherStateSaved,
-            AsWeakPtr(),
-            callback),
-        base::SequencedTaskRunnerHandle::Get()));
 
-  writer.WriteNow(std::make_unique<std::string>(publisher_state));
+  publisher_state_writer_->Save(publisher_state,
+      base::BindOnce(&RewardsServiceImpl::OnPublisherStateSaved,
+          AsWeakPtr(),
+          callback));
 }
 
 void RewardsServiceImpl::OnPublisherStateSaved(
@@ -1105,6 +1115,19 @@ void RewardsServiceImpl::LoadURL(
 
   for (size_t i = 0; i < headers.size(); i++)
     request->headers.AddHeaderFromString(headers[i]);
+
+  if (url_cache_->IsCacheable(*request)) {
+    url_cache_->Fetch(
+        std::move(request),
+        content::BrowserContext::GetDefaultStoragePartition(profile_)
+            ->GetURLLoaderFactoryForBrowserProcess().get(),
+        GetNetworkTrafficAnnotationTagForURLLoad(),
+        base::BindOnce(&RewardsServiceImpl::OnCachedURLLoaderComplete,
+                       AsWeakPtr(),
+                       callback));
+    return;
+  }
+
   network::SimpleURLLoader* loader = network::SimpleURLLoader::Create(
       std::move(request),
       GetNetworkTrafficAnnotationTagForURLLoad()).release();
@@ -1167,6 +1190,16 @@ void RewardsServiceImpl::OnURLLoaderComplete(
   }
 }
 
+void RewardsServiceImpl::OnCachedURLLoaderComplete(
+    ledger::LoadURLCallback callback,
+    const int response_code,
+    const std::string& response_body,
+    const std::map<std::string, std::string>& headers) {
+  if (Connected()) {
+    callback(response_code, response_body, headers);
+  }
+}
+
 void RewardsServiceImpl::OnFetchWalletProperties(
     const ledger::Result result,
     ledger::WalletPropertiesPtr properties) {
@@ -1553,13 +1586,15 @@ void RewardsServiceImpl::SaveState(const std::string& name,
   base::ImportantFileWriter writer(
       rewards_base_path_.AppendASCII(name), file_task_runner_);
 
+  // The callback has a WeakPtr so this won't crash if the file finishes
+  // writing after RewardsServiceImpl has been destroyed
   writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(&PostWriteCallback,
-                 base::Bind(&RewardsServiceImpl::OnSavedState,
-                            AsWeakPtr(),
-                            std::move(callback)),
-                 base::SequencedTaskRunnerHandle::Get()));
+      base::OnceClosure(),
+      base::BindOnce(&PostWriteCallback,
+                     base::BindOnce(&RewardsServiceImpl::OnSavedState,
+                                    AsWeakPtr(),
+                                    std::move(callback)),
+                     base::SequencedTaskRunnerHandle::Get()));
 
   writer.WriteNow(std::make_unique<std::string>(value));
 }
@@ -1596,6 +1631,9 @@ void RewardsServiceImpl::ResetTheWholeState(
   paths.push_back(publisher_info_db_path_);
   paths.push_back(publisher_list_path_);
   paths.push_back(rewards_base_path_);
+  url_cache_->Clear();
+  ledger_state_writer_->Cancel();
+  publisher_state_writer_->Cancel();
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
@@ -71,6 +71,8 @@ namespace brave_rewards {
 
 class RewardsDatabase;
 class RewardsNotificationServiceImpl;
+class RewardsStateWriter;
+class RewardsURLCache;
 class BraveRewardsBrowserTest;
 
 using GetEnvironmentCallback = base::Callback<void(ledger::Environment)>;
@@ -392,6 +394,11 @@ class RewardsServiceImpl : public RewardsService,
     GetPendingContributionsCallback callback,
     ledger::PendingContributionInfoList list);
 
+  void OnCachedURLLoaderComplete(
+      ledger::LoadURLCallback callback,
+      const int response_code,
+      const std::string& response_body,
+      const std::map<std::string, std::string>& headers);
   void OnURLLoaderComplete(network::SimpleURLLoader* loader,
                            ledger::LoadURLCallback callback,
                            std::unique_ptr<std::string> response_body);
@@ -704,6 +711,9 @@ class RewardsServiceImpl : public RewardsService,
   const base::FilePath publisher_list_path_;
   const base::FilePath rewards_base_path_;
   std::unique_ptr<RewardsDatabase> rewards_database_;
+  std::unique_ptr<RewardsURLCache> url_cache_;
+  std::unique_ptr<RewardsStateWriter> ledger_state_writer_;
+  std::unique_ptr<RewardsStateWriter> publisher_state_writer_;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
   std::unique_ptr<RewardsServiceObserver> extension_observer_;
@@ -0,0 +1,109 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_state_writer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
+namespace brave_rewards {
+
+void PostWriteCallback(
+    base::OnceCallback<void(bool success)> callback,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    bool write_success) {
+  // We can't run |callback| on the current thread. Bounce back to
+  // the |reply_task_runner| which is the correct sequenced thread.
+  reply_task_runner->PostTask(FROM_HERE,
+      base::BindOnce(std::move(callback), write_success));
+}
+
+RewardsStateWriter::RewardsStateWriter(
+    const base::FilePath& path,
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const base::TimeDelta commit_interval)
+    : writer_(path, task_runner, commit_interval) {
+}
+
+RewardsStateWriter::~RewardsStateWriter() {
+  Flush();
+}
+
+void RewardsStateWriter::Save(
+    const std::string& data,
+    SaveCallback callback) {
+  data_ = data;
+  is_dirty_ = true;
+  callbacks_.push_back(std::move(callback));
+
+  writer_.ScheduleWrite(this);
+}
+
+void RewardsStateWriter::Flush() {
+  if (!writer_.HasPendingWrite()) {
+    return;
+  }
+
+  writer_.DoScheduledWrite();
+}
+
+void RewardsStateWriter::Cancel() {
+  data_.clear();
+  is_dirty_ = false;
+  callbacks_.clear();
+}
+
+bool RewardsStateWriter::HasPendingWrite() const {
+  return is_dirty_;
+}
+
+uint64_t RewardsStateWriter::write_count() const {
+  return write_count_;
+}
+
+bool RewardsStateWriter::SerializeData(std::string* output) {
+  DCHECK(output);
+
+  if (!is_dirty_) {
+    return false;
+  }
+
+  // State is serialized by the caller, so only the latest state is handed
+  // over to the write on |task_runner|
+  *output = std::move(data_);
+  data_.clear();
+  is_dirty_ = false;
+
+  writer_.RegisterOnNextWriteCallbacks(
+      base::OnceClosure(),
+      base::BindOnce(&PostWriteCallback,
+          base::BindOnce(&RewardsStateWriter::OnWritten,
+              weak_factory_.GetWeakPtr(),
+              std::move(callbacks_)),
+          base::SequencedTaskRunnerHandle::Get()));
+  callbacks_.clear();
+
+  write_count_++;
+
+  return true;
+}
+
+void RewardsStateWriter::OnWritten(
+    std::vector<SaveCallback> callbacks,
+    const bool success) {
+  if (!success) {
+    LOG(ERROR) << "Failed to write " << writer_.path().value();
+  }
+
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(success);
+  }
+}
+
+}  // namespace brave_rewards
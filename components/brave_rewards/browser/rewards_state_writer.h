@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_STATE_WRITER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_STATE_WRITER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_rewards {
+
+// Runs |callback| with the result of an ImportantFileWriter write on
+// |reply_task_runner|, as write callbacks run on the writer's task runner
+void PostWriteCallback(
+    base::OnceCallback<void(bool success)> callback,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    bool write_success);
+
+// Persists a state file which is replaced as a whole on every change. Changes
+// within |commit_interval| are coalesced into one atomic write of the latest
+// state on |task_runner|, callbacks of the coalesced changes run once the
+// write completed
+class RewardsStateWriter : public base::ImportantFileWriter::DataSerializer {
+ public:
+  using SaveCallback = base::OnceCallback<void(bool success)>;
+
+  RewardsStateWriter(
+      const base::FilePath& path,
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      const base::TimeDelta commit_interval);
+  ~RewardsStateWriter() override;
+
+  void Save(const std::string& data, SaveCallback callback);
+
+  // Writes pending state now, state files must be flushed before they are
+  // read and on shutdown
+  void Flush();
+
+  // Drops pending state without writing it
+  void Cancel();
+
+  bool HasPendingWrite() const;
+
+  uint64_t write_count() const;
+
+  // ImportantFileWriter::DataSerializer implementation
+  bool SerializeData(std::string* output) override;
+
+ private:
+  void OnWritten(
+      std::vector<SaveCallback> callbacks,
+      const bool success);
+
+  base::ImportantFileWriter writer_;
+
+  std::string data_;
+  bool is_dirty_ = false;
+  std::vector<SaveCallback> callbacks_;
+
+  uint64_t write_count_ = 0;
+
+  base::WeakPtrFactory<RewardsStateWriter> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(RewardsStateWriter);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_STATE_WRITER_H_
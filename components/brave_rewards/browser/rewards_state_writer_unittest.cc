@@ -0,0 +1,160 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_state_writer.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsStateWriterTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const int kCommitIntervalInSeconds = 2;
+
+std::string GetState(const int version) {
+  return base::StringPrintf("{\"version\":%d}", version);
+}
+
+}  // namespace
+
+class RewardsStateWriterTest : public ::testing::Test {
+ protected:
+  RewardsStateWriterTest() :
+      task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+  }
+
+  ~RewardsStateWriterTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("ledger_state");
+
+    writer_ = std::make_unique<RewardsStateWriter>(
+        path_,
+        base::CreateSequencedTaskRunner(
+            {base::ThreadPool(), base::MayBlock()}),
+        base::TimeDelta::FromSeconds(kCommitIntervalInSeconds));
+  }
+
+  void Save(const std::string& data) {
+    writer_->Save(data, base::BindLambdaForTesting([this](bool success) {
+      EXPECT_TRUE(success);
+      saved_count_++;
+    }));
+  }
+
+  void CommitPendingWrites() {
+    task_environment_.FastForwardBy(
+        base::TimeDelta::FromSeconds(kCommitIntervalInSeconds));
+    task_environment_.RunUntilIdle();
+  }
+
+  std::string ReadState() {
+    std::string data;
+    base::ReadFileToString(path_, &data);
+    return data;
+  }
+
+  int CountFiles() {
+    base::FileEnumerator files(temp_dir_.GetPath(), false,
+        base::FileEnumerator::FILES);
+
+    int count = 0;
+    for (base::FilePath file = files.Next(); !file.empty();
+        file = files.Next()) {
+      count++;
+    }
+
+    return count;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  std::unique_ptr<RewardsStateWriter> writer_;
+  int saved_count_ = 0;
+};
+
+TEST_F(RewardsStateWriterTest, CoalescesBurstIntoOneWrite) {
+  for (int i = 1; i <= 1000; i++) {
+    Save(GetState(i));
+  }
+
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ(0u, writer_->write_count());
+
+  CommitPendingWrites();
+
+  EXPECT_EQ(1u, writer_->write_count());
+  EXPECT_EQ(1000, saved_count_);
+  EXPECT_EQ(GetState(1000), ReadState());
+  EXPECT_FALSE(writer_->HasPendingWrite());
+}
+
+TEST_F(RewardsStateWriterTest, KeepsPreviousStateUntilCommitted) {
+  Save(GetState(1));
+  CommitPendingWrites();
+
+  Save(GetState(2));
+  task_environment_.RunUntilIdle();
+
+  // A kill before the commit interval elapsed leaves the previous state,
+  // which is complete as state is replaced atomically
+  const std::string state = ReadState();
+  EXPECT_EQ(GetState(1), state);
+  EXPECT_TRUE(base::JSONReader::Read(state).has_value());
+  EXPECT_EQ(1, CountFiles());
+
+  CommitPendingWrites();
+
+  EXPECT_EQ(GetState(2), ReadState());
+  EXPECT_EQ(2u, writer_->write_count());
+}
+
+TEST_F(RewardsStateWriterTest, FlushWritesPendingState) {
+  Save(GetState(1));
+
+  writer_->Flush();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(GetState(1), ReadState());
+  EXPECT_EQ(1, saved_count_);
+}
+
+TEST_F(RewardsStateWriterTest, FlushesOnDestruction) {
+  Save(GetState(1));
+
+  writer_.reset();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(GetState(1), ReadState());
+}
+
+TEST_F(RewardsStateWriterTest, CancelDropsPendingState) {
+  Save(GetState(1));
+
+  writer_->Cancel();
+  CommitPendingWrites();
+
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ(0u, writer_->write_count());
+  EXPECT_EQ(0, saved_count_);
+}
+
+}  // namespace brave_rewards
@@ -27,6 +27,8 @@ const char kRewardsNotificationStartupDelay[] =
 const char kRewardsExternalWallets[] = "brave.rewards.external_wallets";
 const char kStateServerPublisherListStamp[] =
     "brave.rewards.server_publisher_list_stamp";
+const char kStateServerPublisherListETags[] =
+    "brave.rewards.server_publisher_list_etags";
 const char kStateUpholdAnonAddress[] =
     "brave.rewards.uphold_anon_address";
 const char kRewardsBadgeText[] = "brave.rewards.badge_text";
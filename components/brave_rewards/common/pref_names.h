@@ -25,6 +25,7 @@ extern const char kRewardsBadgeText[];
 
 // Defined in native-ledger
 extern const char kStateServerPublisherListStamp[];
+extern const char kStateServerPublisherListETags[];
 extern const char kStateUpholdAnonAddress[];
 extern const char kStatePromotionLastFetchStamp[];
 extern const char kStatePromotionCorruptedMigrated[];
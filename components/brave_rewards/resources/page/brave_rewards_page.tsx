@@ -37,6 +37,14 @@ window.cr.define('brave_rewards', function () {
         </ThemeProvider>
       </Provider>,
       document.getElementById('root'))
+
+    // Attention is normalized when it's read, so the auto-contribute list is
+    // fetched again whenever the page is shown
+    document.addEventListener('visibilitychange', () => {
+      if (!document.hidden) {
+        getActions().getContributeList()
+      }
+    })
   }
 
   function getActions () {
@@ -0,0 +1,225 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/browser/bookmark_node.h"
+
+namespace brave_sync {
+
+namespace {
+
+std::string GetObjectId(const bookmarks::BookmarkNode* node) {
+  std::string object_id;
+  node->GetMetaInfo("object_id", &object_id);
+  return object_id;
+}
+
+}  // namespace
+
+BookmarkObjectIdIndex::BookmarkObjectIdIndex(bookmarks::BookmarkModel* model)
+    : model_(model) {
+  DCHECK(model_);
+  model_->AddObserver(this);
+}
+
+BookmarkObjectIdIndex::~BookmarkObjectIdIndex() {
+  if (model_)
+    model_->RemoveObserver(this);
+}
+
+const bookmarks::BookmarkNode* BookmarkObjectIdIndex::Find(
+    const std::string& object_id) {
+  if (object_id.empty() || !model_ || !model_->loaded())
+    return nullptr;
+
+  // Object id of the permanent nodes is written directly, "Other Bookmarks"
+  // gets a new one on every iteration
+  for (const auto& permanent_node : model_->root_node()->children()) {
+    if (GetObjectId(permanent_node.get()) == object_id)
+      return permanent_node.get();
+  }
+
+  if (needs_rebuild_) {
+    Reset();
+    for (const auto& permanent_node : model_->root_node()->children()) {
+      for (const auto& child : permanent_node->children())
+        AddSubtree(child.get());
+    }
+    needs_rebuild_ = false;
+  }
+
+  UpdatePending();
+
+  std::vector<const bookmarks::BookmarkNode*> stale_nodes;
+  const bookmarks::BookmarkNode* found = nullptr;
+  auto range = object_id_to_nodes_.equal_range(object_id);
+  for (auto it = range.first; it != range.second && !found; ++it) {
+    if (GetObjectId(it->second) == object_id)
+      found = it->second;
+    else
+      stale_nodes.push_back(it->second);
+  }
+
+  for (const auto* node : stale_nodes)
+    IndexNode(node);
+
+  if (found)
+    return found;
+
+  UpdateUnassigned();
+
+  range = object_id_to_nodes_.equal_range(object_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (GetObjectId(it->second) == object_id)
+      return it->second;
+  }
+
+  return nullptr;
+}
+
+void BookmarkObjectIdIndex::OnObjectIdsAssigned() {
+  unassigned_nodes_changed_ = true;
+}
+
+void BookmarkObjectIdIndex::BookmarkModelLoaded(
+    bookmarks::BookmarkModel* model,
+    bool ids_reassigned) {
+  Reset();
+}
+
+void BookmarkObjectIdIndex::BookmarkModelBeingDeleted(
+    bookmarks::BookmarkModel* model) {
+  Reset();
+  model_->RemoveObserver(this);
+  model_ = nullptr;
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeAdded(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t index) {
+  if (needs_rebuild_)
+    return;
+
+  AddSubtree(parent->children()[index].get());
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeRemoved(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t old_index,
+    const bookmarks::BookmarkNode* node,
+    const std::set<GURL>& no_longer_bookmarked) {
+  if (needs_rebuild_)
+    return;
+
+  RemoveSubtree(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  if (needs_rebuild_ || node->is_permanent_node())
+    return;
+
+  pending_nodes_.insert(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkMetaInfoChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  BookmarkNodeChanged(model, node);
+}
+
+void BookmarkObjectIdIndex::BookmarkAllUserNodesRemoved(
+    bookmarks::BookmarkModel* model,
+    const std::set<GURL>& removed_urls) {
+  Reset();
+}
+
+void BookmarkObjectIdIndex::Reset() {
+  object_id_to_nodes_.clear();
+  node_to_object_id_.clear();
+  pending_nodes_.clear();
+  unassigned_nodes_.clear();
+  unassigned_nodes_changed_ = false;
+  needs_rebuild_ = true;
+}
+
+void BookmarkObjectIdIndex::AddSubtree(const bookmarks::BookmarkNode* node) {
+  pending_nodes_.insert(node);
+  for (const auto& child : node->children())
+    AddSubtree(child.get());
+}
+
+void BookmarkObjectIdIndex::RemoveSubtree(
+    const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+  for (const auto& child : node->children())
+    RemoveSubtree(child.get());
+}
+
+void BookmarkObjectIdIndex::RemoveNode(const bookmarks::BookmarkNode* node) {
+  pending_nodes_.erase(node);
+  unassigned_nodes_.erase(node);
+
+  auto it = node_to_object_id_.find(node);
+  if (it == node_to_object_id_.end())
+    return;
+
+  auto range = object_id_to_nodes_.equal_range(it->second);
+  for (auto node_it = range.first; node_it != range.second; ++node_it) {
+    if (node_it->second == node) {
+      object_id_to_nodes_.erase(node_it);
+      break;
+    }
+  }
+  node_to_object_id_.erase(it);
+}
+
+void BookmarkObjectIdIndex::UpdatePending() {
+  if (pending_nodes_.empty())
+    return;
+
+  std::unordered_set<const bookmarks::BookmarkNode*> pending_nodes;
+  pending_nodes.swap(pending_nodes_);
+  for (const auto* node : pending_nodes)
+    IndexNode(node);
+}
+
+void BookmarkObjectIdIndex::UpdateUnassigned() {
+  if (!unassigned_nodes_changed_)
+    return;
+  unassigned_nodes_changed_ = false;
+
+  std::vector<const bookmarks::BookmarkNode*> assigned_nodes;
+  for (const auto* node : unassigned_nodes_) {
+    if (!GetObjectId(node).empty())
+      assigned_nodes.push_back(node);
+  }
+
+  for (const auto* node : assigned_nodes)
+    IndexNode(node);
+}
+
+void BookmarkObjectIdIndex::IndexNode(const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+
+  const std::string object_id = GetObjectId(node);
+  if (object_id.empty()) {
+    unassigned_nodes_.insert(node);
+    return;
+  }
+
+  object_id_to_nodes_.emplace(object_id, node);
+  node_to_object_id_.emplace(node, object_id);
+}
+
+}  // namespace brave_sync
@@ -0,0 +1,107 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "base/macros.h"
+#include "components/bookmarks/browser/bookmark_model_observer.h"
+
+namespace bookmarks {
+class BookmarkModel;
+class BookmarkNode;
+}  // namespace bookmarks
+
+namespace brave_sync {
+
+// Maps sync object ids to bookmark nodes. The index is kept up to date from
+// model notifications, nodes which were added or changed are (re)indexed on
+// the next lookup because brave sync meta info is partly written without
+// notifying the model observers. Permanent nodes are never indexed and are
+// checked directly
+class BookmarkObjectIdIndex : public bookmarks::BookmarkModelObserver {
+ public:
+  explicit BookmarkObjectIdIndex(bookmarks::BookmarkModel* model);
+  ~BookmarkObjectIdIndex() override;
+
+  // Returns the node with |object_id| or nullptr
+  const bookmarks::BookmarkNode* Find(const std::string& object_id);
+
+  // Should be called after nodes were committed, as committing writes their
+  // object ids without notifying the model observers
+  void OnObjectIdsAssigned();
+
+  size_t size() const { return node_to_object_id_.size(); }
+
+  // bookmarks::BookmarkModelObserver implementation
+  void BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                           bool ids_reassigned) override;
+  void BookmarkModelBeingDeleted(bookmarks::BookmarkModel* model) override;
+  void BookmarkNodeMoved(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* old_parent,
+                         size_t old_index,
+                         const bookmarks::BookmarkNode* new_parent,
+                         size_t new_index) override {}
+  void BookmarkNodeAdded(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* parent,
+                         size_t index) override;
+  void BookmarkNodeRemoved(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* parent,
+      size_t old_index,
+      const bookmarks::BookmarkNode* node,
+      const std::set<GURL>& no_longer_bookmarked) override;
+  void BookmarkNodeChanged(bookmarks::BookmarkModel* model,
+                           const bookmarks::BookmarkNode* node) override;
+  void BookmarkMetaInfoChanged(bookmarks::BookmarkModel* model,
+                               const bookmarks::BookmarkNode* node) override;
+  void BookmarkNodeFaviconChanged(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkNodeChildrenReordered(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkAllUserNodesRemoved(
+      bookmarks::BookmarkModel* model,
+      const std::set<GURL>& removed_urls) override;
+
+ private:
+  void Reset();
+  void AddSubtree(const bookmarks::BookmarkNode* node);
+  void RemoveSubtree(const bookmarks::BookmarkNode* node);
+  void RemoveNode(const bookmarks::BookmarkNode* node);
+
+  // Reads object ids of nodes which were added or changed since the last
+  // lookup. Nodes without object id are read again on the first lookup miss
+  // after OnObjectIdsAssigned(), they get their object id once committed
+  void UpdatePending();
+  void UpdateUnassigned();
+  void IndexNode(const bookmarks::BookmarkNode* node);
+
+  bookmarks::BookmarkModel* model_;  // NOT OWNED
+
+  bool needs_rebuild_ = true;
+  bool unassigned_nodes_changed_ = false;
+
+  // Several nodes can share one object id if a bookmark was copied along with
+  // its meta info
+  std::unordered_multimap<std::string, const bookmarks::BookmarkNode*>
+      object_id_to_nodes_;
+  std::unordered_map<const bookmarks::BookmarkNode*, std::string>
+      node_to_object_id_;
+  std::unordered_set<const bookmarks::BookmarkNode*> pending_nodes_;
+  std::unordered_set<const bookmarks::BookmarkNode*> unassigned_nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(BookmarkObjectIdIndex);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
@@ -0,0 +1,214 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_sync/tools.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/models/tree_node_iterator.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BookmarkObjectIdIndexTest.*
+
+using bookmarks::BookmarkModel;
+using bookmarks::BookmarkNode;
+
+namespace brave_sync {
+
+namespace {
+
+// The full tree walk which was done for every incoming record
+const BookmarkNode* FindByObjectIdReference(BookmarkModel* model,
+                                            const std::string& object_id) {
+  ui::TreeNodeIterator<const BookmarkNode> iterator(model->root_node());
+  while (iterator.has_next()) {
+    const BookmarkNode* node = iterator.Next();
+    std::string node_object_id;
+    node->GetMetaInfo("object_id", &node_object_id);
+
+    if (!node_object_id.empty() && object_id == node_object_id)
+      return node;
+  }
+  return nullptr;
+}
+
+std::string GetObjectId(const int id) {
+  return "object_" + base::NumberToString(id);
+}
+
+}  // namespace
+
+class BookmarkObjectIdIndexTest : public testing::Test {
+ protected:
+  BookmarkObjectIdIndexTest()
+      : model_(bookmarks::TestBookmarkClient::CreateModel()),
+        index_(std::make_unique<BookmarkObjectIdIndex>(model_.get())) {}
+
+  ~BookmarkObjectIdIndexTest() override {}
+
+  const BookmarkNode* AddURL(const BookmarkNode* parent,
+                             const std::string& object_id) {
+    const BookmarkNode* node = model_->AddURL(
+        parent, parent->children().size(), base::ASCIIToUTF16(object_id),
+        GURL("https://example.com/" + object_id));
+    if (!object_id.empty())
+      model_->SetNodeMetaInfo(node, "object_id", object_id);
+    return node;
+  }
+
+  const BookmarkNode* AddFolder(const BookmarkNode* parent,
+                                const std::string& object_id) {
+    const BookmarkNode* node = model_->AddFolder(
+        parent, parent->children().size(), base::ASCIIToUTF16(object_id));
+    model_->SetNodeMetaInfo(node, "object_id", object_id);
+    return node;
+  }
+
+  // Adds |count| bookmarks spread over folders of 100 bookmarks
+  void AddBookmarks(const int count) {
+    const BookmarkNode* folder = nullptr;
+    for (int i = 0; i < count; ++i) {
+      if (i % 100 == 0)
+        folder = AddFolder(model_->other_node(), "folder_" + GetObjectId(i));
+      AddURL(folder, GetObjectId(i));
+    }
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<BookmarkModel> model_;
+  std::unique_ptr<BookmarkObjectIdIndex> index_;
+};
+
+TEST_F(BookmarkObjectIdIndexTest, FindsNodesByObjectId) {
+  const BookmarkNode* folder = AddFolder(model_->bookmark_bar_node(), "a");
+  const BookmarkNode* child = AddURL(folder, "a1");
+  const BookmarkNode* other = AddURL(model_->other_node(), "b");
+
+  EXPECT_EQ(folder, index_->Find("a"));
+  EXPECT_EQ(child, index_->Find("a1"));
+  EXPECT_EQ(other, index_->Find("b"));
+  EXPECT_EQ(nullptr, index_->Find("c"));
+  EXPECT_EQ(nullptr, index_->Find(""));
+  EXPECT_EQ(3u, index_->size());
+}
+
+TEST_F(BookmarkObjectIdIndexTest, TracksModelChanges) {
+  const BookmarkNode* folder = AddFolder(model_->bookmark_bar_node(), "a");
+  AddURL(folder, "a1");
+  EXPECT_EQ(folder, index_->Find("a"));
+
+  const BookmarkNode* added = AddURL(model_->other_node(), "b");
+  EXPECT_EQ(added, index_->Find("b"));
+
+  model_->SetNodeMetaInfo(added, "object_id", "c");
+  EXPECT_EQ(nullptr, index_->Find("b"));
+  EXPECT_EQ(added, index_->Find("c"));
+
+  model_->Move(added, folder, 0);
+  EXPECT_EQ(added, index_->Find("c"));
+
+  model_->Remove(folder);
+  EXPECT_EQ(nullptr, index_->Find("a"));
+  EXPECT_EQ(nullptr, index_->Find("a1"));
+  EXPECT_EQ(nullptr, index_->Find("c"));
+  EXPECT_EQ(0u, index_->size());
+
+  const BookmarkNode* copied = AddFolder(model_->other_node(), "d");
+  model_->Copy(copied, model_->other_node(), 0);
+  EXPECT_NE(nullptr, index_->Find("d"));
+
+  model_->RemoveAllUserBookmarks();
+  EXPECT_EQ(nullptr, index_->Find("d"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, FindsObjectIdWrittenWithoutNotification) {
+  const BookmarkNode* node = AddURL(model_->bookmark_bar_node(), "");
+  EXPECT_EQ(nullptr, index_->Find("a"));
+
+  // Brave sync meta info is written like this when a node is committed
+  tools::AsMutable(node)->SetMetaInfo("object_id", "a");
+  index_->OnObjectIdsAssigned();
+  EXPECT_EQ(node, index_->Find("a"));
+
+  tools::AsMutable(node)->SetMetaInfo("object_id", "b");
+  EXPECT_EQ(nullptr, index_->Find("a"));
+  EXPECT_EQ(node, index_->Find("b"));
+
+  tools::AsMutable(model_->other_node())->SetMetaInfo("object_id", "c");
+  EXPECT_EQ(model_->other_node(), index_->Find("c"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, ReadsUnassignedNodesOncePerCommit) {
+  const int kUnassignedCount = 1000;
+  std::vector<const BookmarkNode*> nodes;
+  for (int i = 0; i < kUnassignedCount; ++i)
+    nodes.push_back(AddURL(model_->bookmark_bar_node(), ""));
+
+  // Misses don't read the unassigned nodes again until a commit assigned
+  // object ids
+  for (int i = 0; i < kUnassignedCount; ++i)
+    EXPECT_EQ(nullptr, index_->Find(GetObjectId(i)));
+
+  for (int i = 0; i < kUnassignedCount; ++i)
+    tools::AsMutable(nodes[i])->SetMetaInfo("object_id", GetObjectId(i));
+  index_->OnObjectIdsAssigned();
+
+  for (int i = 0; i < kUnassignedCount; ++i)
+    EXPECT_EQ(nodes[i], index_->Find(GetObjectId(i)));
+  EXPECT_EQ(static_cast<size_t>(kUnassignedCount), index_->size());
+}
+
+TEST_F(BookmarkObjectIdIndexTest, SyncCyclesOnLargeModel) {
+  const int kBookmarksCount = 20000;
+  const int kCyclesCount = 5;
+  const int kRecordsPerCycle = 1000;
+
+  AddBookmarks(kBookmarksCount);
+
+  int next_object_id = kBookmarksCount;
+  for (int cycle = 0; cycle < kCyclesCount; ++cycle) {
+    // Stand-in for the records of a poll cycle: updates of existing bookmarks
+    // mixed with bookmarks created on other devices
+    std::vector<std::string> records;
+    for (int i = 0; i < kRecordsPerCycle; ++i) {
+      records.push_back(i % 4 == 0 ? GetObjectId(next_object_id++)
+                                   : GetObjectId((cycle * 7919 + i * 13) %
+                                                 kBookmarksCount));
+    }
+
+    base::ElapsedTimer timer;
+    std::vector<const BookmarkNode*> found;
+    for (const auto& object_id : records) {
+      const BookmarkNode* node = index_->Find(object_id);
+      if (!node)
+        node = AddURL(model_->bookmark_bar_node(), object_id);
+      found.push_back(node);
+    }
+    LOG(INFO) << "Sync cycle " << cycle << " resolved " << records.size()
+              << " records in " << timer.Elapsed().InMilliseconds() << "ms";
+
+    for (size_t i = 0; i < records.size(); i += 50) {
+      EXPECT_EQ(FindByObjectIdReference(model_.get(), records[i]), found[i]);
+    }
+  }
+
+  // Bookmarks added in the last cycle are indexed on the next lookup
+  EXPECT_NE(nullptr, index_->Find(GetObjectId(0)));
+  EXPECT_EQ(static_cast<size_t>(next_object_id + kBookmarksCount / 100),
+            index_->size());
+}
+
+}  // namespace brave_sync
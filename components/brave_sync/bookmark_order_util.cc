@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_sync/bookmark_order_util.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 
@@ -55,69 +58,130 @@ std::string ToOrderString(const std::vector<int>& vec_int) {
 
 bool CompareOrder(const std::string& left, const std::string& right) {
   // Return: true if left <  right
-  // Split each and compare as int vectors
-  std::vector<int> vec_left = OrderToIntVect(left);
-  std::vector<int> vec_right = OrderToIntVect(right);
-
-  return CompareOrder(vec_left, vec_right);
+  return BookmarkOrder(left) < BookmarkOrder(right);
 }
 
 namespace {
 
-std::string GetNextOrderFromPrevOrder(std::vector<int>* vec_prev) {
-  DCHECK_GT(vec_prev->size(), 2u);
-  int last_number = vec_prev->at(vec_prev->size() - 1);
+size_t HashComponents(const std::vector<int>& components) {
+  size_t hash = components.size();
+  for (const int component : components) {
+    hash = hash * 31 + static_cast<size_t>(component);
+  }
+  return hash;
+}
+
+BookmarkOrder GetNextOrderFromPrevOrder(std::vector<int> vec_prev) {
+  DCHECK_GT(vec_prev.size(), 2u);
+  int last_number = vec_prev.at(vec_prev.size() - 1);
   DCHECK_GT(last_number, 0);
   if (last_number <= 0) {
-    return "";
+    return BookmarkOrder();
   } else {
-    vec_prev->at(vec_prev->size() - 1)++;
-    return ToOrderString(*vec_prev);
+    vec_prev.at(vec_prev.size() - 1)++;
+    return BookmarkOrder(std::move(vec_prev));
   }
 }
 
-std::string GetPrevOrderFromNextOrder(std::vector<int>* vec_next) {
-  DCHECK_GT(vec_next->size(), 2u);
-  int last_number = vec_next->at(vec_next->size() - 1);
+BookmarkOrder GetPrevOrderFromNextOrder(std::vector<int> vec_next) {
+  DCHECK_GT(vec_next.size(), 2u);
+  int last_number = vec_next.at(vec_next.size() - 1);
   DCHECK_GT(last_number, 0);
-  vec_next->resize(vec_next->size() - 1);
+  vec_next.resize(vec_next.size() - 1);
   if (last_number <= 0) {
-    return "";
+    return BookmarkOrder();
   } else if (last_number == 1) {
-    return ToOrderString(*vec_next) + ".0.1";
+    vec_next.push_back(0);
+    vec_next.push_back(1);
+    return BookmarkOrder(std::move(vec_next));
   } else {
-    vec_next->push_back(last_number - 1);
-    return ToOrderString(*vec_next);
+    vec_next.push_back(last_number - 1);
+    return BookmarkOrder(std::move(vec_next));
   }
 }
 
 }  // namespace
 
+BookmarkOrder::BookmarkOrder() : hash_(HashComponents(components_)) {}
+
+BookmarkOrder::BookmarkOrder(const std::string& order)
+    : BookmarkOrder(OrderToIntVect(order)) {}
+
+BookmarkOrder::BookmarkOrder(std::vector<int> components)
+    : components_(std::move(components)),
+      hash_(HashComponents(components_)) {}
+
+BookmarkOrder::BookmarkOrder(const BookmarkOrder& other) = default;
+
+BookmarkOrder::BookmarkOrder(BookmarkOrder&& other) = default;
+
+BookmarkOrder& BookmarkOrder::operator=(const BookmarkOrder& other) = default;
+
+BookmarkOrder& BookmarkOrder::operator=(BookmarkOrder&& other) = default;
+
+BookmarkOrder::~BookmarkOrder() = default;
+
+bool BookmarkOrder::operator<(const BookmarkOrder& other) const {
+  return CompareOrder(components_, other.components_);
+}
+
+bool BookmarkOrder::operator==(const BookmarkOrder& other) const {
+  return hash_ == other.hash_ && components_ == other.components_;
+}
+
+bool BookmarkOrder::operator!=(const BookmarkOrder& other) const {
+  return !(*this == other);
+}
+
+bool BookmarkOrder::empty() const {
+  return components_.empty();
+}
+
+size_t BookmarkOrder::hash() const {
+  return hash_;
+}
+
+const std::vector<int>& BookmarkOrder::components() const {
+  return components_;
+}
+
+std::string BookmarkOrder::ToString() const {
+  return ToOrderString(components_);
+}
+
 // Inspired by https://github.com/brave/sync/blob/staging/client/bookmarkUtil.js
 std::string GetOrder(const std::string& prev,
                      const std::string& next,
                      const std::string& parent) {
+  return GetOrderBetween(BookmarkOrder(prev),
+                         BookmarkOrder(next),
+                         BookmarkOrder(parent)).ToString();
+}
+
+BookmarkOrder GetOrderBetween(const BookmarkOrder& prev,
+                              const BookmarkOrder& next,
+                              const BookmarkOrder& parent) {
   if (prev.empty() && next.empty()) {
     DCHECK(!parent.empty());
-    return parent + ".1";
+    std::vector<int> vec_result = parent.components();
+    vec_result.push_back(1);
+    return BookmarkOrder(std::move(vec_result));
   } else if (!prev.empty() && next.empty()) {
-    std::vector<int> vec_prev = OrderToIntVect(prev);
-    DCHECK_GT(vec_prev.size(), 2u);
+    DCHECK_GT(prev.components().size(), 2u);
     // Just increase the last number, as we don't have next
-    return GetNextOrderFromPrevOrder(&vec_prev);
+    return GetNextOrderFromPrevOrder(prev.components());
   } else if (prev.empty() && !next.empty()) {
-    std::vector<int> vec_next = OrderToIntVect(next);
-    DCHECK_GT(vec_next.size(), 2u);
+    DCHECK_GT(next.components().size(), 2u);
     // Just decrease the last number or substitute with 0.1,
     // as we don't have prev
-    return GetPrevOrderFromNextOrder(&vec_next);
+    return GetPrevOrderFromNextOrder(next.components());
   } else {
     DCHECK(!prev.empty() && !next.empty());
-    std::vector<int> vec_prev = OrderToIntVect(prev);
+    const std::vector<int>& vec_prev = prev.components();
     DCHECK_GT(vec_prev.size(), 2u);
-    std::vector<int> vec_next = OrderToIntVect(next);
+    const std::vector<int>& vec_next = next.components();
     DCHECK_GT(vec_next.size(), 2u);
-    DCHECK(CompareOrder(prev, next));
+    DCHECK(prev < next);
 
     // Assume prev looks as a.b.c.d
     // result candidates are:
@@ -139,7 +203,7 @@ std::string GetOrder(const std::string& prev,
     // Case a.b.c.(d+1)
     DCHECK(CompareOrder(vec_prev, vec_result));
     if (CompareOrder(vec_result, vec_next)) {
-      return ToOrderString(vec_result);
+      return BookmarkOrder(std::move(vec_result));
     }
 
     vec_result = vec_prev;
@@ -147,7 +211,7 @@ std::string GetOrder(const std::string& prev,
     // Case a.b.c.d.1
     DCHECK(CompareOrder(vec_prev, vec_result));
     if (CompareOrder(vec_result, vec_next)) {
-      return ToOrderString(vec_result);
+      return BookmarkOrder(std::move(vec_result));
     }
 
     size_t insert_at = vec_prev.size();
@@ -157,12 +221,12 @@ std::string GetOrder(const std::string& prev,
       vec_result.insert(vec_result.begin() + insert_at, 0);
       DCHECK(CompareOrder(vec_prev, vec_result));
       if (CompareOrder(vec_result, vec_next)) {
-        return ToOrderString(vec_result);
+        return BookmarkOrder(std::move(vec_result));
       }
     }
 
-    NOTREACHED() << "[BraveSync] " << __func__ << " prev=" << prev
-                 << " next=" << next << " terminated with "
+    NOTREACHED() << "[BraveSync] " << __func__ << " prev=" << prev.ToString()
+                 << " next=" << next.ToString() << " terminated with "
                  << ToOrderString(vec_result);
   }
 
@@ -170,7 +234,7 @@ std::string GetOrder(const std::string& prev,
                << " condition is not handled prev.empty()=" << prev.empty()
                << " next.empty()=" << next.empty();
 
-  return "";
+  return BookmarkOrder();
 }
 
 }  // namespace brave_sync
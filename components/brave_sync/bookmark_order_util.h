@@ -6,11 +6,53 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_ORDER_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_ORDER_UTIL_H_
 
+#include <stddef.h>
+
 #include <string>
 #include <vector>
 
 namespace brave_sync {
 
+// Bookmark order parsed once from its dotted form, such as "1.7.3.12", so
+// sorting and inserting into large folders doesn't tokenize the same strings
+// on every comparison
+class BookmarkOrder {
+ public:
+  BookmarkOrder();
+  explicit BookmarkOrder(const std::string& order);
+  explicit BookmarkOrder(std::vector<int> components);
+  BookmarkOrder(const BookmarkOrder& other);
+  BookmarkOrder(BookmarkOrder&& other);
+  BookmarkOrder& operator=(const BookmarkOrder& other);
+  BookmarkOrder& operator=(BookmarkOrder&& other);
+  ~BookmarkOrder();
+
+  bool operator<(const BookmarkOrder& other) const;
+  bool operator==(const BookmarkOrder& other) const;
+  bool operator!=(const BookmarkOrder& other) const;
+
+  bool empty() const;
+  size_t hash() const;
+  const std::vector<int>& components() const;
+
+  std::string ToString() const;
+
+ private:
+  std::vector<int> components_;
+  size_t hash_;
+};
+
+struct BookmarkOrderHash {
+  size_t operator()(const BookmarkOrder& order) const {
+    return order.hash();
+  }
+};
+
+// Same as |GetOrder| for parsed orders, returns an empty order on failure
+BookmarkOrder GetOrderBetween(const BookmarkOrder& prev,
+                              const BookmarkOrder& next,
+                              const BookmarkOrder& parent);
+
   std::vector<int> OrderToIntVect(const std::string& s);
   std::string ToOrderString(const std::vector<int>& vec_int);
   bool CompareOrder(const std::string& left, const std::string& right);
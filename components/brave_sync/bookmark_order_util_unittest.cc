@@ -5,10 +5,41 @@
 
 #include "brave/components/brave_sync/bookmark_order_util.h"
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_sync {
 
+namespace {
+
+// Random order like the ones assigned by sync, which always have at least
+// three components
+std::string GetRandomOrder(std::mt19937* generator) {
+  std::uniform_int_distribution<int> size_distribution(3, 8);
+  std::uniform_int_distribution<int> component_distribution(0, 12);
+
+  std::vector<int> components(size_distribution(*generator));
+  for (auto& component : components) {
+    component = component_distribution(*generator);
+  }
+  components.back() = std::max(components.back(), 1);
+
+  return ToOrderString(components);
+}
+
+bool CompareOrderReference(const std::string& left, const std::string& right) {
+  const std::vector<int> vec_left = OrderToIntVect(left);
+  const std::vector<int> vec_right = OrderToIntVect(right);
+  return std::lexicographical_compare(vec_left.begin(), vec_left.end(),
+                                      vec_right.begin(), vec_right.end());
+}
+
+}  // namespace
+
 TEST(BookmarkOrderUtilTest, OrderToIntVect_EmptyString) {
   std::vector<int> result = OrderToIntVect("");
   EXPECT_TRUE(result.empty());
@@ -112,4 +143,84 @@ TEST(BookmarkOrderUtilTest, GetOrder) {
   EXPECT_EQ(GetOrder("1.1.1.2.1", "1.1.1.3", ""), "1.1.1.2.2");
 }
 
+TEST(BookmarkOrderUtilTest, BookmarkOrder) {
+  const BookmarkOrder order("1.7.3.12");
+  EXPECT_EQ(std::vector<int>({1, 7, 3, 12}), order.components());
+  EXPECT_EQ("1.7.3.12", order.ToString());
+  EXPECT_EQ(BookmarkOrder("1.7.3.12").hash(), order.hash());
+  EXPECT_TRUE(order == BookmarkOrder(std::vector<int>({1, 7, 3, 12})));
+  EXPECT_TRUE(order != BookmarkOrder("1.7.3.1.2"));
+  EXPECT_TRUE(BookmarkOrder().empty());
+  EXPECT_TRUE(BookmarkOrder("").empty());
+}
+
+TEST(BookmarkOrderUtilTest, BookmarkOrderEquivalentToStringCompare) {
+  std::mt19937 generator(20200401);
+
+  for (int i = 0; i < 10000; i++) {
+    const std::string left = GetRandomOrder(&generator);
+    const std::string right = i % 10 == 0 ? left : GetRandomOrder(&generator);
+
+    const BookmarkOrder parsed_left(left);
+    const BookmarkOrder parsed_right(right);
+
+    EXPECT_EQ(CompareOrderReference(left, right), parsed_left < parsed_right)
+        << left << " < " << right;
+    EXPECT_EQ(CompareOrderReference(left, right), CompareOrder(left, right))
+        << left << " < " << right;
+    EXPECT_EQ(left == right, parsed_left == parsed_right)
+        << left << " == " << right;
+    if (parsed_left == parsed_right) {
+      EXPECT_EQ(parsed_left.hash(), parsed_right.hash());
+    }
+    EXPECT_EQ(left, parsed_left.ToString());
+  }
+}
+
+TEST(BookmarkOrderUtilTest, GetOrderBetweenEquivalentToGetOrder) {
+  std::mt19937 generator(20200402);
+
+  for (int i = 0; i < 10000; i++) {
+    std::string prev = GetRandomOrder(&generator);
+    std::string next = GetRandomOrder(&generator);
+    if (prev == next) {
+      continue;
+    }
+    if (CompareOrder(next, prev)) {
+      std::swap(prev, next);
+    }
+
+    const BookmarkOrder order = GetOrderBetween(BookmarkOrder(prev),
+        BookmarkOrder(next), BookmarkOrder());
+
+    EXPECT_EQ(GetOrder(prev, next, ""), order.ToString());
+    EXPECT_TRUE(BookmarkOrder(prev) < order) << prev << " < " << next;
+    EXPECT_TRUE(order < BookmarkOrder(next)) << prev << " < " << next;
+  }
+}
+
+TEST(BookmarkOrderUtilTest, Sort50kBookmarksByParsedOrder) {
+  std::mt19937 generator(20200403);
+
+  std::vector<std::string> orders;
+  for (int i = 0; i < 50000; i++) {
+    orders.push_back(GetRandomOrder(&generator));
+  }
+
+  // Orders are parsed once instead of once per comparison
+  std::vector<BookmarkOrder> parsed_orders;
+  parsed_orders.reserve(orders.size());
+  for (const auto& order : orders) {
+    parsed_orders.emplace_back(order);
+  }
+  std::stable_sort(parsed_orders.begin(), parsed_orders.end());
+
+  std::stable_sort(orders.begin(), orders.end(), CompareOrderReference);
+
+  ASSERT_EQ(orders.size(), parsed_orders.size());
+  for (size_t i = 0; i < orders.size(); i++) {
+    EXPECT_EQ(orders[i], parsed_orders[i].ToString());
+  }
+}
+
 }  // namespace brave_sync
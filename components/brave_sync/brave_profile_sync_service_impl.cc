@@ -11,11 +11,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
 #include "brave/components/brave_sync/brave_sync_service_observer.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
@@ -36,7 +38,6 @@
 #include "components/sync/engine_impl/syncer.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/network_interfaces.h"
-#include "ui/base/models/tree_node_iterator.h"
 
 namespace brave_sync {
 
@@ -106,21 +107,6 @@ RecordsListPtr CreateDeviceRecord(const std::string& device_name,
   return records;
 }
 
-const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
-                                              const std::string& object_id) {
-  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(
-      model->root_node());
-  while (iterator.has_next()) {
-    const bookmarks::BookmarkNode* node = iterator.Next();
-    std::string node_object_id;
-    node->GetMetaInfo("object_id", &node_object_id);
-
-    if (!node_object_id.empty() && object_id == node_object_id)
-      return node;
-  }
-  return nullptr;
-}
-
 std::unique_ptr<SyncRecord> CreateDeleteBookmarkByObjectId(
     const prefs::Prefs* brave_sync_prefs,
     const std::string& object_id) {
@@ -287,6 +273,10 @@ void BraveProfileSyncServiceImpl::OnNudgeSyncCycle(RecordsListPtr records) {
   if (!brave_sync_prefs_->GetSyncEnabled())
     return;
 
+  // Committed bookmarks got their object ids without model notifications
+  if (object_id_index_)
+    object_id_index_->OnObjectIdsAssigned();
+
   for (auto& record : *records) {
     record->deviceId = brave_sync_prefs_->GetThisDeviceId();
     CheckOtherBookmarkRecord(record.get());
@@ -372,9 +362,7 @@ void BraveProfileSyncServiceImpl::OnSetupSyncNewToSync(
 void BraveProfileSyncServiceImpl::OnDeleteDevice(
     const std::string& device_id_v2) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  auto sync_devices = brave_sync_prefs_->GetSyncDevices();
-
-  const SyncDevice* device = sync_devices->GetByDeviceIdV2(device_id_v2);
+  const SyncDevice* device = GetSyncDevices()->GetByDeviceIdV2(device_id_v2);
   if (device) {
     const std::string device_name = device->name_;
     const std::string device_id = device->device_id_;
@@ -393,9 +381,7 @@ void BraveProfileSyncServiceImpl::OnDeleteDevice(
 
 void BraveProfileSyncServiceImpl::OnResetSync() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  auto sync_devices = brave_sync_prefs_->GetSyncDevices();
-
-  if (sync_devices->size() == 0) {
+  if (GetSyncDevices()->size() == 0) {
     // Fail safe option
     VLOG(2) << "[Sync] " << __func__ << " unexpected zero device size";
     ResetSyncInternal();
@@ -411,7 +397,7 @@ void BraveProfileSyncServiceImpl::GetSettingsAndDevices(
     const GetSettingsAndDevicesCallback& callback) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   auto settings = brave_sync_prefs_->GetBraveSyncSettings();
-  auto devices = brave_sync_prefs_->GetSyncDevices();
+  auto devices = std::make_unique<SyncDevices>(*GetSyncDevices());
   callback.Run(std::move(settings), std::move(devices));
 }
 
@@ -614,7 +600,7 @@ syncer::ModelTypeSet BraveProfileSyncServiceImpl::GetPreferredDataTypes()
 std::unique_ptr<SyncRecordAndExistingList>
 BraveProfileSyncServiceImpl::PrepareResolvedPreferences(
     const RecordsList& records) {
-  auto sync_devices = brave_sync_prefs_->GetSyncDevices();
+  SyncDevices* sync_devices = GetSyncDevices();
   auto records_and_existing_objects =
       std::make_unique<SyncRecordAndExistingList>();
 
@@ -766,6 +752,7 @@ void BraveProfileSyncServiceImpl::OnConnectionChanged(
 
 void BraveProfileSyncServiceImpl::Shutdown() {
   SignalWaitableEvent();
+  object_id_index_.reset();
   syncer::ProfileSyncService::Shutdown();
 }
 
@@ -905,7 +892,7 @@ BraveProfileSyncServiceImpl::BookmarkNodeToSyncBookmark(
 
 void BraveProfileSyncServiceImpl::SaveSyncEntityInfo(
     const jslib::SyncRecord* record) {
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   // no need to save for DELETE
   if (node) {
     auto& bookmark = record->GetBookmark();
@@ -930,7 +917,7 @@ void BraveProfileSyncServiceImpl::LoadSyncEntityInfo(
   auto* bookmark = record->mutable_bookmark();
   if (!bookmark->metaInfo.empty())
     return;
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   if (node) {
     AddSyncEntityInfo(bookmark, node, "position_in_parent");
     AddSyncEntityInfo(bookmark, node, "version");
@@ -1080,7 +1067,7 @@ void BraveProfileSyncServiceImpl::CreateResolveList(
     }
     auto resolved_record = std::make_unique<SyncRecordAndExisting>();
     resolved_record->first = SyncRecord::Clone(*record);
-    auto* node = FindByObjectId(model_, record->objectId);
+    auto* node = FindByObjectId(record->objectId);
     if (node) {
       resolved_record->second = BookmarkNodeToSyncBookmark(node);
     }
@@ -1089,6 +1076,26 @@ void BraveProfileSyncServiceImpl::CreateResolveList(
   }
 }
 
+const bookmarks::BookmarkNode* BraveProfileSyncServiceImpl::FindByObjectId(
+    const std::string& object_id) {
+  DCHECK(model_);
+  if (!object_id_index_)
+    object_id_index_ = std::make_unique<BookmarkObjectIdIndex>(model_);
+  return object_id_index_->Find(object_id);
+}
+
+SyncDevices* BraveProfileSyncServiceImpl::GetSyncDevices() {
+  if (!sync_devices_)
+    sync_devices_ = brave_sync_prefs_->GetSyncDevices();
+  return sync_devices_.get();
+}
+
+void BraveProfileSyncServiceImpl::SaveSyncDevices() {
+  DCHECK(sync_devices_);
+  base::AutoReset<bool> saving(&saving_sync_devices_, true);
+  brave_sync_prefs_->SetSyncDevices(*sync_devices_);
+}
+
 bool BraveProfileSyncServiceImpl::IsSQSReady() const {
   // During 70 sec after device connected to chain use start_at parameter
   // of empty to force fetch from S3.
@@ -1171,9 +1178,8 @@ void BraveProfileSyncServiceImpl::SendDeleteDevice() {
   std::string device_id = brave_sync_prefs_->GetThisDeviceId();
   std::string device_id_v2 = brave_sync_prefs_->GetThisDeviceIdV2();
   if (object_id.empty()) {
-    auto sync_devices = brave_sync_prefs_->GetSyncDevices();
     std::vector<const SyncDevice*> devices =
-        sync_devices->GetByDeviceId(device_id);
+        GetSyncDevices()->GetByDeviceId(device_id);
     for (auto* device : devices) {
       if (device) {
         object_id = device->object_id_;
@@ -1211,7 +1217,7 @@ void BraveProfileSyncServiceImpl::OnResolvedPreferences(
       brave_sync_prefs_->GetThisDeviceIdV2();
   bool this_device_deleted = false;
 
-  auto sync_devices = brave_sync_prefs_->GetSyncDevices();
+  SyncDevices* sync_devices = GetSyncDevices();
   for (const auto& record : records) {
     DCHECK(record->has_device() || record->has_sitesetting());
     if (record->has_device()) {
@@ -1232,7 +1238,7 @@ void BraveProfileSyncServiceImpl::OnResolvedPreferences(
     }
   }  // for each device
 
-  brave_sync_prefs_->SetSyncDevices(*sync_devices);
+  SaveSyncDevices();
   if (this_device_deleted) {
     ResetSyncInternal();
   }
@@ -1244,6 +1250,8 @@ void BraveProfileSyncServiceImpl::OnBraveSyncPrefsChanged(
     brave_sync_client_->OnSyncEnabledChanged();
     RecordSyncStateP3A();
   } else if (pref == prefs::kSyncDeviceList) {
+    if (!saving_sync_devices_)
+      sync_devices_.reset();
     RecordSyncStateP3A();
   }
   NotifySyncStateChanged();
@@ -1353,7 +1361,7 @@ void BraveProfileSyncServiceImpl::ResendSyncRecords(
     DCHECK(model_->loaded());
 
     for (auto& object_id : records_to_resend) {
-      auto* node = FindByObjectId(model_, object_id);
+      auto* node = FindByObjectId(object_id);
 
       // Check resend interval
       const base::DictionaryValue* meta =
@@ -71,6 +71,9 @@ namespace prefs {
 class Prefs;
 }  // namespace prefs
 
+class BookmarkObjectIdIndex;
+class SyncDevices;
+
 using bookmarks::BookmarkModel;
 using bookmarks::BookmarkNode;
 
@@ -280,6 +283,14 @@ class BraveProfileSyncServiceImpl
   void CheckOtherBookmarkRecord(jslib::SyncRecord* record);
   void CheckOtherBookmarkChildRecord(jslib::SyncRecord* record);
 
+  // Looks up the bookmark synced as |object_id| in |object_id_index_|
+  const bookmarks::BookmarkNode* FindByObjectId(const std::string& object_id);
+
+  // Returns |sync_devices_|, parsed from prefs on first use
+  SyncDevices* GetSyncDevices();
+  // Writes |sync_devices_| to prefs without dropping it
+  void SaveSyncDevices();
+
   void CreateResolveList(
       const std::vector<std::unique_ptr<jslib::SyncRecord>>& records,
       SyncRecordAndExistingList* records_and_existing_objects);
@@ -329,6 +340,14 @@ class BraveProfileSyncServiceImpl
 
   bookmarks::BookmarkModel* model_ = nullptr;
 
+  // Created on the first lookup, so that it only observes a loaded model
+  std::unique_ptr<BookmarkObjectIdIndex> object_id_index_;
+
+  // Devices from prefs along with their lookup index, dropped when the pref is
+  // changed by anything but SaveSyncDevices()
+  std::unique_ptr<SyncDevices> sync_devices_;
+  bool saving_sync_devices_ = false;
+
   std::unique_ptr<BraveSyncClient> brave_sync_client_;
 
   std::unique_ptr<RecordsList> pending_received_records_;
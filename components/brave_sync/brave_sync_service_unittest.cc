@@ -130,7 +130,7 @@ bool DevicesContains(brave_sync::SyncDevices* devices,
                      const std::string& id_v2,
                      const std::string& name) {
   DCHECK(devices);
-  for (const auto& device : devices->devices_) {
+  for (const auto& device : devices->devices()) {
     if (device.device_id_ == id && device.name_ == name &&
         device.device_id_v2_ == id_v2) {
       return true;
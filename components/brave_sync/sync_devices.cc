@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_sync/sync_devices.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/json/json_writer.h"
@@ -91,6 +92,7 @@ std::unique_ptr<base::Value> SyncDevices::ToValueArrOnly() const {
 void SyncDevices::FromJson(const std::string& str_json) {
   if (str_json.empty()) {
     devices_.clear();
+    RebuildIndex();
     return;
   }
 
@@ -127,22 +129,25 @@ void SyncDevices::FromJson(const std::string& str_json) {
     devices_.push_back(
         SyncDevice(name, object_id, device_id, device_id_v2, last_active));
   }
+
+  RebuildIndex();
 }
 
 void SyncDevices::Merge(const SyncDevice& device,
                         int action,
                         bool* actually_merged) {
   *actually_merged = false;
-  auto existing_it = std::find_if(std::begin(devices_),
-                                  std::end(devices_),
-      [device](const SyncDevice &cur_dev) {
-        return cur_dev.object_id_ == device.object_id_;
-      });
+  auto existing_it = std::end(devices_);
+  auto index_it = object_id_index_.find(device.object_id_);
+  if (index_it != object_id_index_.end()) {
+    existing_it = std::begin(devices_) + index_it->second;
+  }
 
   switch (action) {
     case jslib_const::kActionCreate: {
       if (existing_it == std::end(devices_)) {
         devices_.push_back(device);
+        AddToIndex(devices_.size() - 1);
         *actually_merged = true;
       } else {
         // ignoring create, already have device
@@ -152,6 +157,7 @@ void SyncDevices::Merge(const SyncDevice& device,
     case jslib_const::kActionUpdate: {
       DCHECK(existing_it != std::end(devices_));
       *existing_it = device;
+      RebuildIndex();
       *actually_merged = true;
       break;
     }
@@ -160,6 +166,7 @@ void SyncDevices::Merge(const SyncDevice& device,
       // at this point existing_it can be equal to std::end(devices_)
       if (existing_it != std::end(devices_)) {
         devices_.erase(existing_it);
+        RebuildIndex();
         *actually_merged = true;
       } else {
         // ignoring delete, already deleted
@@ -170,22 +177,26 @@ void SyncDevices::Merge(const SyncDevice& device,
 }
 
 SyncDevice* SyncDevices::GetByObjectId(const std::string &object_id) {
-  for (auto& device : devices_) {
-    if (device.object_id_ == object_id) {
-      return &device;
-    }
+  auto it = object_id_index_.find(object_id);
+  if (it == object_id_index_.end()) {
+    return nullptr;
   }
 
-  return nullptr;
+  return &devices_[it->second];
 }
 
 std::vector<const SyncDevice*> SyncDevices::GetByDeviceId(
     const std::string& device_id) {
+  std::vector<size_t> positions;
+  auto range = device_id_index_.equal_range(device_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    positions.push_back(it->second);
+  }
+  std::sort(positions.begin(), positions.end());
+
   std::vector<const SyncDevice*> devices;
-  for (const auto& device : devices_) {
-    if (device.device_id_ == device_id) {
-      devices.push_back(&device);
-    }
+  for (const size_t position : positions) {
+    devices.push_back(&devices_[position]);
   }
 
   return devices;
@@ -193,29 +204,41 @@ std::vector<const SyncDevice*> SyncDevices::GetByDeviceId(
 
 const SyncDevice* SyncDevices::GetByDeviceIdV2(
     const std::string& device_id_v2) {
-  for (const auto& device : devices_) {
-    if (device.device_id_v2_ == device_id_v2) {
-      return &device;
-    }
+  auto it = device_id_v2_index_.find(device_id_v2);
+  if (it == device_id_v2_index_.end()) {
+    return nullptr;
   }
 
-  return nullptr;
+  return &devices_[it->second];
 }
 
 void SyncDevices::DeleteByObjectId(const std::string &object_id) {
-  auto existing_it =
-      std::find_if(std::begin(devices_),
-                    std::end(devices_),
-                    [object_id](const SyncDevice &dev) {
-                      return dev.object_id_ == object_id;
-                    });
-
-  if (existing_it != std::end(devices_)) {
-    devices_.erase(existing_it);
+  auto it = object_id_index_.find(object_id);
+  if (it != object_id_index_.end()) {
+    devices_.erase(std::begin(devices_) + it->second);
+    RebuildIndex();
   } else {
     // TODO(bridiver) - is this correct?
     NOTREACHED();
   }
 }
 
+void SyncDevices::RebuildIndex() {
+  object_id_index_.clear();
+  device_id_index_.clear();
+  device_id_v2_index_.clear();
+
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    AddToIndex(i);
+  }
+}
+
+void SyncDevices::AddToIndex(size_t position) {
+  const SyncDevice& device = devices_[position];
+  // First device wins if ids are duplicated, same as the former linear scan
+  object_id_index_.emplace(device.object_id_, position);
+  device_id_index_.emplace(device.device_id_, position);
+  device_id_v2_index_.emplace(device.device_id_v2_, position);
+}
+
 }  // namespace brave_sync
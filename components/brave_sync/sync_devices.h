@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace base {
@@ -41,7 +42,7 @@ class SyncDevices {
  public:
   SyncDevices();
   ~SyncDevices();
-  std::vector<SyncDevice> devices_;
+  const std::vector<SyncDevice>& devices() const { return devices_; }
   std::unique_ptr<base::Value> ToValue() const;
   std::unique_ptr<base::Value> ToValueArrOnly() const;
   std::string ToJson() const;
@@ -54,6 +55,17 @@ class SyncDevices {
   const SyncDevice* GetByDeviceIdV2(const std::string& device_id_v2);
   SyncDevice* GetByObjectId(const std::string& object_id);
   void DeleteByObjectId(const std::string& object_id);
+
+ private:
+  // Lookups by id go through positions in |devices_|, which are rebuilt when
+  // |devices_| is parsed or changed by Merge and DeleteByObjectId
+  void RebuildIndex();
+  void AddToIndex(size_t position);
+
+  std::vector<SyncDevice> devices_;
+  std::unordered_map<std::string, size_t> object_id_index_;
+  std::unordered_multimap<std::string, size_t> device_id_index_;
+  std::unordered_map<std::string, size_t> device_id_v2_index_;
 };
 
 }  // namespace brave_sync
@@ -0,0 +1,71 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/sync_devices.h"
+
+#include <vector>
+
+#include "brave/components/brave_sync/jslib_const.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SyncDevicesTest.*
+
+namespace brave_sync {
+
+TEST(SyncDevicesTest, LookupsFollowMerge) {
+  SyncDevices devices;
+  bool actually_merged = false;
+  devices.Merge(SyncDevice("a", "object_a", "1", "v2_a", 1),
+                jslib_const::kActionCreate, &actually_merged);
+  EXPECT_TRUE(actually_merged);
+  devices.Merge(SyncDevice("b", "object_b", "2", "v2_b", 2),
+                jslib_const::kActionCreate, &actually_merged);
+  devices.Merge(SyncDevice("c", "object_c", "2", "v2_c", 3),
+                jslib_const::kActionCreate, &actually_merged);
+
+  ASSERT_NE(nullptr, devices.GetByObjectId("object_b"));
+  EXPECT_EQ("b", devices.GetByObjectId("object_b")->name_);
+  ASSERT_NE(nullptr, devices.GetByDeviceIdV2("v2_c"));
+  EXPECT_EQ("c", devices.GetByDeviceIdV2("v2_c")->name_);
+  std::vector<const SyncDevice*> by_device_id = devices.GetByDeviceId("2");
+  ASSERT_EQ(2u, by_device_id.size());
+  EXPECT_EQ("b", by_device_id[0]->name_);
+  EXPECT_EQ("c", by_device_id[1]->name_);
+
+  devices.Merge(SyncDevice("a", "object_a", "1", "v2_a", 1),
+                jslib_const::kActionDelete, &actually_merged);
+  EXPECT_TRUE(actually_merged);
+  EXPECT_EQ(nullptr, devices.GetByObjectId("object_a"));
+  EXPECT_EQ(nullptr, devices.GetByDeviceIdV2("v2_a"));
+  ASSERT_NE(nullptr, devices.GetByObjectId("object_c"));
+  EXPECT_EQ("c", devices.GetByObjectId("object_c")->name_);
+
+  devices.Merge(SyncDevice("b2", "object_b", "2", "v2_b2", 4),
+                jslib_const::kActionUpdate, &actually_merged);
+  EXPECT_EQ(nullptr, devices.GetByDeviceIdV2("v2_b"));
+  ASSERT_NE(nullptr, devices.GetByDeviceIdV2("v2_b2"));
+  EXPECT_EQ("b2", devices.GetByDeviceIdV2("v2_b2")->name_);
+
+  devices.DeleteByObjectId("object_b");
+  EXPECT_EQ(nullptr, devices.GetByObjectId("object_b"));
+  EXPECT_EQ(1u, devices.size());
+}
+
+TEST(SyncDevicesTest, LookupsFollowFromJson) {
+  SyncDevices devices;
+  bool actually_merged = false;
+  devices.Merge(SyncDevice("a", "object_a", "1", "v2_a", 1),
+                jslib_const::kActionCreate, &actually_merged);
+
+  SyncDevices parsed;
+  parsed.FromJson(devices.ToJson());
+  ASSERT_NE(nullptr, parsed.GetByObjectId("object_a"));
+  EXPECT_EQ("v2_a", parsed.GetByObjectId("object_a")->device_id_v2_);
+
+  parsed.FromJson("");
+  EXPECT_EQ(nullptr, parsed.GetByObjectId("object_a"));
+}
+
+}  // namespace brave_sync
@@ -45,6 +45,8 @@ size_t GetIndex(const bookmarks::BookmarkNode* parent,
                 const std::string& object_id) {
   DCHECK(!order.empty());
   DCHECK(!object_id.empty());
+  // Parsed once instead of for every child it is compared to
+  const BookmarkOrder parsed_order(order);
   for (size_t i = 0; i < parent->children().size(); ++i) {
     const bookmarks::BookmarkNode* child = parent->children()[i].get();
     // Same order and same object id (case when child is equal to target node)
@@ -52,7 +54,7 @@ size_t GetIndex(const bookmarks::BookmarkNode* parent,
     std::string child_order;
     child->GetMetaInfo("order", &child_order);
     if (!child_order.empty() &&
-        brave_sync::CompareOrder(order, child_order)) {
+        parsed_order < BookmarkOrder(child_order)) {
       return i;
     } else if (order == child_order) {
       std::string child_object_id;
@@ -22,6 +22,7 @@
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "brave/components/greaselion/browser/greaselion_url_matcher.h"
 #include "brave/components/greaselion/browser/switches.h"
 
 using brave_component_updater::LocalDataFilesObserver;
@@ -169,38 +170,24 @@ void GreaselionDownloadService::LoadDirectlyFromResourcePath() {
 }
 GreaselionDownloadService::~GreaselionDownloadService() {}
 
-void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
+void GreaselionDownloadService::ClearRules() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  url_matcher_.reset();
+}
+
+void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  ClearRules();
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
   }
-  base::Optional<base::Value> root = base::JSONReader::Read(contents);
-  if (!root) {
-    LOG(ERROR) << "Failed to parse Greaselion configuration";
+  if (!ParseGreaselionRules(contents, resource_dir_, &rules_))
     return;
-  }
-  base::ListValue* root_list = nullptr;
-  root->GetAsList(&root_list);
-  for (base::Value& rule_it : root_list->GetList()) {
-    base::DictionaryValue* rule_dict = nullptr;
-    rule_it.GetAsDictionary(&rule_dict);
-    base::DictionaryValue* preconditions_value = nullptr;
-    rule_dict->GetDictionary(kPreconditions, &preconditions_value);
-    base::ListValue* urls_value = nullptr;
-    rule_dict->GetList(kURLs, &urls_value);
-    base::ListValue* scripts_value = nullptr;
-    rule_dict->GetList(kScripts, &scripts_value);
-    const std::string* run_at_ptr = rule_it.FindStringPath(kRunAt);
-    const std::string run_at_value = run_at_ptr ? *run_at_ptr : "";
-
-    std::unique_ptr<GreaselionRule> rule = std::make_unique<GreaselionRule>(
-        base::StringPrintf(kRuleNameFormat, rules_.size()));
-    rule->Parse(preconditions_value, urls_value, scripts_value,
-        run_at_value, resource_dir_);
-    rules_.push_back(std::move(rule));
-  }
+  // Rules are converted to extensions only once one of their patterns matches
+  // a navigation, so compiling the patterns is all the work done up front.
+  url_matcher_ = std::make_unique<GreaselionURLMatcher>(rules_);
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
@@ -216,12 +203,17 @@ void GreaselionDownloadService::OnComponentReady(
   LoadDirectlyFromResourcePath();
 }
 
-std::vector<std::unique_ptr<GreaselionRule>>*
+const std::vector<std::unique_ptr<GreaselionRule>>*
 GreaselionDownloadService::rules() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   return &rules_;
 }
 
+const GreaselionURLMatcher* GreaselionDownloadService::url_matcher() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return url_matcher_.get();
+}
+
 scoped_refptr<base::SequencedTaskRunner>
 GreaselionDownloadService::GetTaskRunner() {
   return local_data_files_service()->GetTaskRunner();
@@ -229,6 +221,37 @@ GreaselionDownloadService::GetTaskRunner() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool ParseGreaselionRules(const std::string& contents,
+                          const base::FilePath& resource_dir,
+                          std::vector<std::unique_ptr<GreaselionRule>>* rules) {
+  base::Optional<base::Value> root = base::JSONReader::Read(contents);
+  if (!root) {
+    LOG(ERROR) << "Failed to parse Greaselion configuration";
+    return false;
+  }
+  base::ListValue* root_list = nullptr;
+  root->GetAsList(&root_list);
+  for (base::Value& rule_it : root_list->GetList()) {
+    base::DictionaryValue* rule_dict = nullptr;
+    rule_it.GetAsDictionary(&rule_dict);
+    base::DictionaryValue* preconditions_value = nullptr;
+    rule_dict->GetDictionary(kPreconditions, &preconditions_value);
+    base::ListValue* urls_value = nullptr;
+    rule_dict->GetList(kURLs, &urls_value);
+    base::ListValue* scripts_value = nullptr;
+    rule_dict->GetList(kScripts, &scripts_value);
+    const std::string* run_at_ptr = rule_it.FindStringPath(kRunAt);
+    const std::string run_at_value = run_at_ptr ? *run_at_ptr : "";
+
+    std::unique_ptr<GreaselionRule> rule = std::make_unique<GreaselionRule>(
+        base::StringPrintf(kRuleNameFormat, rules->size()));
+    rule->Parse(preconditions_value, urls_value, scripts_value,
+        run_at_value, resource_dir);
+    rules->push_back(std::move(rule));
+  }
+  return true;
+}
+
 // The factory
 std::unique_ptr<GreaselionDownloadService> GreaselionDownloadServiceFactory(
     LocalDataFilesService* local_data_files_service) {
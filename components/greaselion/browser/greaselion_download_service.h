@@ -25,6 +25,10 @@
 
 class GreaselionServiceTest;
 
+namespace greaselion {
+class GreaselionURLMatcher;
+}  // namespace greaselion
+
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
 
@@ -84,7 +88,11 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
       LocalDataFilesService* local_data_files_service);
   ~GreaselionDownloadService() override;
 
-  std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // The rules are only changed together with url_matcher(), which refers to
+  // them by position.
+  const std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Matches URLs against the patterns of rules(), null until rules are loaded.
+  const GreaselionURLMatcher* url_matcher();
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -105,6 +113,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
  private:
   friend class ::GreaselionServiceTest;
 
+  void ClearRules();
   void OnDATFileDataReady(std::string contents);
   void OnDevModeLocalFileChanged(const base::FilePath& path, bool error);
   void LoadOnTaskRunner();
@@ -112,6 +121,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  std::unique_ptr<GreaselionURLMatcher> url_matcher_;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
   std::unique_ptr<base::FilePathWatcher> dev_mode_path_watcher_;
@@ -121,6 +131,12 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   DISALLOW_COPY_AND_ASSIGN(GreaselionDownloadService);
 };  // namespace greaselion
 
+// Parses the rules of a Greaselion configuration file whose scripts are in
+// |resource_dir| into |rules|. Returns false if |contents| can't be parsed.
+bool ParseGreaselionRules(const std::string& contents,
+                          const base::FilePath& resource_dir,
+                          std::vector<std::unique_ptr<GreaselionRule>>* rules);
+
 // Creates the GreaselionDownloadService
 std::unique_ptr<GreaselionDownloadService> GreaselionDownloadServiceFactory(
     LocalDataFilesService* local_data_files_service);
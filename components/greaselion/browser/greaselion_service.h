@@ -34,6 +34,10 @@ class GreaselionService : public KeyedService,
 
   virtual void SetFeatureEnabled(GreaselionFeature feature, bool enabled) = 0;
   virtual void UpdateInstalledExtensions() = 0;
+  // Installs the extensions of the rules matching |url| unless that was done
+  // for an earlier navigation. Returns true if some of them are not ready
+  // yet, observers are notified when they are.
+  virtual bool ActivateRulesForURL(const GURL& url) = 0;
   virtual bool ready() = 0;
 
   // implementation of our own observers
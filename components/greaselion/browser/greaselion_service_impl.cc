@@ -31,6 +31,7 @@
 #include "brave/common/brave_switches.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "brave/components/greaselion/browser/greaselion_url_matcher.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "chrome/common/chrome_paths.h"
 #include "crypto/sha2.h"
@@ -161,6 +162,17 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   temp_dir.Take();  // The caller takes ownership of the directory.
   return extension;
 }
+
+// Rule names are their positions in the configuration, so activations are
+// kept by what a rule injects where, which stays the same for a rule when the
+// configuration is updated.
+std::string GetActivationKey(const greaselion::GreaselionRule& rule) {
+  std::vector<std::string> parts = rule.url_patterns();
+  parts.push_back(rule.run_at());
+  for (const base::FilePath& script : rule.scripts())
+    parts.push_back(script.AsUTF8Unsafe());
+  return base::JoinString(parts, "\n");
+}
 }  // namespace
 
 namespace greaselion {
@@ -178,6 +190,7 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       extension_registry_(extension_registry),
       all_rules_installed_successfully_(true),
       update_in_progress_(false),
+      pending_update_(false),
       pending_installs_(0),
       task_runner_(std::move(task_runner)),
       weak_factory_(this) {
@@ -214,34 +227,81 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
   }
 }
 
+bool GreaselionServiceImpl::ActivateRulesForURL(const GURL& url) {
+  const GreaselionURLMatcher* url_matcher = download_service_->url_matcher();
+  if (!url_matcher)
+    return false;
+
+  const std::vector<std::unique_ptr<GreaselionRule>>* rules =
+      download_service_->rules();
+  bool matched = false;
+  std::vector<GreaselionRule*> activated_rules;
+  for (size_t index : url_matcher->GetMatchingRules(url)) {
+    DCHECK_LT(index, rules->size());
+    GreaselionRule* rule = (*rules)[index].get();
+    if (!rule->Matches(state_) || rule->has_unknown_preconditions())
+      continue;
+    matched = true;
+    if (activated_rules_.insert(GetActivationKey(*rule)).second)
+      activated_rules.push_back(rule);
+  }
+  if (!matched)
+    return false;
+
+  if (update_in_progress_) {
+    // The running update may have already skipped the newly activated rules,
+    // so it runs again once done.
+    if (!activated_rules.empty())
+      pending_update_ = true;
+    return true;
+  }
+  if (activated_rules.empty())
+    return false;
+
+  // The extensions of the other rules stay as they are.
+  update_in_progress_ = true;
+  all_rules_installed_successfully_ = true;
+  InstallRules(activated_rules);
+  return true;
+}
+
+bool GreaselionServiceImpl::ShouldInstall(const GreaselionRule& rule) const {
+  return activated_rules_.count(GetActivationKey(rule)) &&
+         rule.Matches(state_) &&
+         rule.has_unknown_preconditions() == false;
+}
+
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
   DCHECK(greaselion_extensions_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
+  std::vector<GreaselionRule*> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (ShouldInstall(*rule))
+      rules.push_back(rule.get());
   }
+  InstallRules(rules);
+}
+
+void GreaselionServiceImpl::InstallRules(
+    const std::vector<GreaselionRule*>& rules) {
+  DCHECK(update_in_progress_);
+  pending_installs_ = static_cast<int>(rules.size());
   if (!pending_installs_) {
     // no rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (GreaselionRule* rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr()));
   }
 }
 
@@ -308,6 +368,11 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 void GreaselionServiceImpl::MaybeNotifyObservers() {
   if (!pending_installs_) {
     update_in_progress_ = false;
+    if (pending_update_) {
+      pending_update_ = false;
+      UpdateInstalledExtensions();
+      return;
+    }
     for (Observer& observer : observers_)
       observer.OnExtensionsReady(this, all_rules_installed_successfully_);
   }
@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_url_matcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "url/gurl.h"
+
+namespace greaselion {
+
+namespace {
+
+// URLPattern ignores the trailing dot of fully qualified hosts.
+std::string GetHostForMatching(base::StringPiece host) {
+  if (host.ends_with("."))
+    host.remove_suffix(1);
+  return host.as_string();
+}
+
+}  // namespace
+
+GreaselionURLMatcher::GreaselionURLMatcher(
+    const std::vector<std::unique_ptr<GreaselionRule>>& rules) {
+  for (size_t i = 0; i < rules.size(); ++i) {
+    for (const std::string& pattern_string : rules[i]->url_patterns()) {
+      // Same schemes as GreaselionRule::Parse() accepts.
+      URLPattern pattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS);
+      if (pattern.Parse(pattern_string) != URLPattern::ParseResult::kSuccess)
+        continue;
+
+      const size_t index = patterns_.size();
+      const std::string host = GetHostForMatching(pattern.host());
+      if (host.empty() && pattern.match_subdomains())
+        any_host_patterns_.push_back(index);
+      else
+        patterns_by_host_[host].push_back(index);
+      patterns_.push_back({std::move(pattern), i});
+    }
+  }
+}
+
+GreaselionURLMatcher::~GreaselionURLMatcher() = default;
+
+std::vector<size_t> GreaselionURLMatcher::GetMatchingRules(
+    const GURL& url) const {
+  std::vector<size_t> result;
+  for (size_t index : any_host_patterns_) {
+    if (patterns_[index].pattern.MatchesURL(url))
+      result.push_back(patterns_[index].rule_index);
+  }
+
+  // URLPattern matches filesystem: URLs by their inner URL.
+  const GURL& host_url =
+      url.SchemeIsFileSystem() && url.inner_url() ? *url.inner_url() : url;
+  const std::string host = GetHostForMatching(host_url.host_piece());
+  AddCandidates(host, url, &result);
+  for (size_t dot = host.find('.'); dot != std::string::npos;
+       dot = host.find('.', dot + 1)) {
+    AddCandidates(host.substr(dot + 1), url, &result);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void GreaselionURLMatcher::AddCandidates(const std::string& host,
+                                         const GURL& url,
+                                         std::vector<size_t>* result) const {
+  const auto it = patterns_by_host_.find(host);
+  if (it == patterns_by_host_.end())
+    return;
+  // The index only narrows the candidates down, the patterns decide.
+  for (size_t index : it->second) {
+    if (patterns_[index].pattern.MatchesURL(url))
+      result->push_back(patterns_[index].rule_index);
+  }
+}
+
+}  // namespace greaselion
@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_URL_MATCHER_H_
+#define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_URL_MATCHER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace greaselion {
+
+class GreaselionRule;
+
+// Finds the Greaselion rules whose URL patterns match a URL. The patterns of
+// all rules are compiled once into an index by host, so a URL is checked
+// against the patterns for its host and parent domains only instead of every
+// pattern of every rule.
+class GreaselionURLMatcher {
+ public:
+  explicit GreaselionURLMatcher(
+      const std::vector<std::unique_ptr<GreaselionRule>>& rules);
+  ~GreaselionURLMatcher();
+
+  // Returns the positions of the rules matching |url| in ascending order.
+  std::vector<size_t> GetMatchingRules(const GURL& url) const;
+
+  size_t patterns_count() const { return patterns_.size(); }
+
+ private:
+  struct Pattern {
+    URLPattern pattern;
+    size_t rule_index;
+  };
+
+  void AddCandidates(const std::string& host,
+                     const GURL& url,
+                     std::vector<size_t>* result) const;
+
+  std::vector<Pattern> patterns_;
+  // Patterns by their host, without a trailing dot. Patterns which match
+  // subdomains are looked up for every parent domain of a URL.
+  std::unordered_map<std::string, std::vector<size_t>> patterns_by_host_;
+  // Patterns which match any host.
+  std::vector<size_t> any_host_patterns_;
+
+  DISALLOW_COPY_AND_ASSIGN(GreaselionURLMatcher);
+};
+
+}  // namespace greaselion
+
+#endif  // BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_URL_MATCHER_H_
@@ -0,0 +1,183 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_url_matcher.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=GreaselionURLMatcherTest.*
+
+namespace greaselion {
+
+namespace {
+
+using Rules = std::vector<std::unique_ptr<GreaselionRule>>;
+
+// Builds a configuration with a rule for each list of URL patterns.
+std::string GetConfiguration(
+    const std::vector<std::vector<std::string>>& rule_patterns) {
+  std::vector<std::string> rules;
+  for (const auto& patterns : rule_patterns) {
+    rules.push_back(base::StringPrintf(
+        R"({"urls": ["%s"], "scripts": ["script.js"]})",
+        base::JoinString(patterns, "\", \"").c_str()));
+  }
+  return "[" + base::JoinString(rules, ", ") + "]";
+}
+
+Rules ParseRules(const std::string& configuration) {
+  Rules rules;
+  EXPECT_TRUE(ParseGreaselionRules(
+      configuration, base::FilePath(FILE_PATH_LITERAL("greaselion")), &rules));
+  return rules;
+}
+
+// Rules matching |url| the way their content scripts are matched.
+std::vector<size_t> GetMatchingRulesByPatterns(const Rules& rules,
+                                               const GURL& url) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    for (const std::string& pattern_string : rules[i]->url_patterns()) {
+      URLPattern pattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS);
+      if (pattern.Parse(pattern_string) == URLPattern::ParseResult::kSuccess &&
+          pattern.MatchesURL(url)) {
+        result.push_back(i);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(GreaselionURLMatcherTest, MatchesSameRulesAsURLPatterns) {
+  const Rules rules = ParseRules(GetConfiguration({
+      {"https://www.example.com/*"},
+      {"*://*.example.com/*"},
+      {"https://example.org/path/*", "http://example.org/"},
+      {"*://*/*"},
+      {"https://*.co.uk/*"},
+      {"https://example.net:8443/*"},
+      {"*://twitter.com/*", "https://*.twitter.com/*"},
+      {"https://127.0.0.1/*"},
+      {"<all_urls>"},
+      {"https://*/login*"},
+  }));
+  ASSERT_EQ(10u, rules.size());
+  const GreaselionURLMatcher matcher(rules);
+  EXPECT_EQ(12u, matcher.patterns_count());
+
+  for (const char* spec : {
+           "https://www.example.com/",
+           "http://www.example.com/",
+           "https://example.com/",
+           "https://a.b.example.com/page?x=1",
+           "https://example.com./",
+           "https://www.example.com./",
+           "https://notexample.com/",
+           "https://example.com.evil.com/",
+           "https://example.org/path/to",
+           "https://example.org/path",
+           "http://example.org/",
+           "http://example.org/other",
+           "https://bbc.co.uk/",
+           "https://www.bbc.co.uk/news",
+           "https://co.uk/",
+           "https://example.net:8443/",
+           "https://example.net/",
+           "http://twitter.com/brave",
+           "https://mobile.twitter.com/brave",
+           "https://twitter.com.br/",
+           "https://127.0.0.1/",
+           "https://1.127.0.0.1/",
+           "https://[::1]/",
+           "https://accounts.example.com/login?next=/",
+           "ftp://www.example.com/",
+           "file:///etc/passwd",
+           "chrome://settings",
+           "filesystem:https://www.example.com/temporary/file",
+           "about:blank",
+       }) {
+    const GURL url(spec);
+    EXPECT_EQ(GetMatchingRulesByPatterns(rules, url),
+              matcher.GetMatchingRules(url))
+        << spec;
+  }
+}
+
+TEST(GreaselionURLMatcherTest, SkipsRulesWithMalformedPatterns) {
+  const Rules rules = ParseRules(GetConfiguration({
+      {"https://www.example.com/*", "not a pattern"},
+      {"https://www.example.com/*"},
+  }));
+  const GreaselionURLMatcher matcher(rules);
+
+  EXPECT_EQ(std::vector<size_t>({1}),
+            matcher.GetMatchingRules(GURL("https://www.example.com/")));
+}
+
+TEST(GreaselionURLMatcherTest, StartupWithManyRules) {
+  const size_t kRulesCount = 500;
+  std::vector<std::vector<std::string>> rule_patterns;
+  for (size_t i = 0; i < kRulesCount; ++i) {
+    rule_patterns.push_back(
+        {base::StringPrintf("https://site%zu.example.com/*", i),
+         base::StringPrintf("*://*.site%zu.example.org/path/*", i % 50)});
+  }
+  const std::string configuration = GetConfiguration(rule_patterns);
+
+  // The rules are only parsed and their patterns compiled at startup, their
+  // extensions are created once a navigation matches them.
+  const base::TimeTicks startup_start = base::TimeTicks::Now();
+  const Rules rules = ParseRules(configuration);
+  const GreaselionURLMatcher matcher(rules);
+  const base::TimeDelta startup_time = base::TimeTicks::Now() - startup_start;
+  ASSERT_EQ(kRulesCount, rules.size());
+  EXPECT_EQ(2 * kRulesCount, matcher.patterns_count());
+
+  std::vector<GURL> urls;
+  for (size_t i = 0; i < 100; ++i) {
+    urls.push_back(GURL(base::StringPrintf(
+        "https://site%zu.example.com/index.html", i * 7 % kRulesCount)));
+    urls.push_back(GURL(base::StringPrintf(
+        "https://www.site%zu.example.org/path/page", i % 60)));
+    urls.push_back(GURL(base::StringPrintf("https://other%zu.com/", i)));
+  }
+
+  base::TimeDelta matcher_time;
+  base::TimeDelta patterns_time;
+  for (const GURL& url : urls) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    const std::vector<size_t> matches = matcher.GetMatchingRules(url);
+    matcher_time += base::TimeTicks::Now() - start;
+
+    start = base::TimeTicks::Now();
+    const std::vector<size_t> expected = GetMatchingRulesByPatterns(rules, url);
+    patterns_time += base::TimeTicks::Now() - start;
+
+    EXPECT_EQ(expected, matches) << url;
+  }
+
+  LOG(INFO) << kRulesCount << " rules loaded in "
+            << startup_time.InMicroseconds() << "us, " << urls.size()
+            << " navigations took " << matcher_time.InMicroseconds()
+            << "us with the matcher and " << patterns_time.InMicroseconds()
+            << "us checking every pattern";
+}
+
+}  // namespace greaselion
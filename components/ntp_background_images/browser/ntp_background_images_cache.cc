@@ -0,0 +1,103 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/files/file_util.h"
+#include "base/task/post_task.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::Optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+NTPBackgroundImagesCache::NTPBackgroundImagesCache(size_t max_size_in_bytes)
+    : max_size_in_bytes_(max_size_in_bytes),
+      images_(ImagesCache::NO_AUTO_EVICT),
+      weak_factory_(this) {
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&NTPBackgroundImagesCache::OnMemoryPressure,
+                 base::Unretained(this))));
+}
+
+NTPBackgroundImagesCache::~NTPBackgroundImagesCache() = default;
+
+void NTPBackgroundImagesCache::GetImage(const base::FilePath& image_file,
+                                        GotImageCallback callback) {
+  auto it = images_.Get(image_file);
+  if (it != images_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  auto& callbacks = pending_callbacks_[image_file];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1)
+    return;
+
+  disk_reads_count_++;
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&ReadFileToString, image_file),
+      base::BindOnce(&NTPBackgroundImagesCache::OnGotImageFile,
+                     weak_factory_.GetWeakPtr(), image_file, generation_));
+}
+
+void NTPBackgroundImagesCache::Prefetch(const base::FilePath& image_file) {
+  if (image_file.empty())
+    return;
+  GetImage(image_file, base::DoNothing());
+}
+
+void NTPBackgroundImagesCache::Clear() {
+  images_.Clear();
+  size_in_bytes_ = 0;
+  generation_++;
+}
+
+void NTPBackgroundImagesCache::OnGotImageFile(
+    const base::FilePath& image_file,
+    int generation,
+    base::Optional<std::string> input) {
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (input)
+    bytes = base::RefCountedString::TakeString(&input.value());
+
+  // Images bigger than the whole cache are served but not kept.
+  if (bytes && generation == generation_ &&
+      bytes->size() <= max_size_in_bytes_) {
+    images_.Put(image_file, bytes);
+    size_in_bytes_ += bytes->size();
+    while (size_in_bytes_ > max_size_in_bytes_) {
+      auto oldest = images_.rbegin();
+      size_in_bytes_ -= oldest->second->size();
+      images_.Erase(oldest);
+    }
+  }
+
+  auto callbacks = std::move(pending_callbacks_[image_file]);
+  pending_callbacks_.erase(image_file);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPBackgroundImagesCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  Clear();
+}
+
+}  // namespace ntp_background_images
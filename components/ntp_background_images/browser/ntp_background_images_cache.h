@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+
+namespace ntp_background_images {
+
+// Keeps encoded bytes of recently served NTP images in memory so that opening
+// new tabs doesn't read multi-megabyte files from disk again and again.
+// Cached bytes are shared with the requests through refcounted memory.
+// The cache is dropped under memory pressure and when component data changes.
+class NTPBackgroundImagesCache {
+ public:
+  using GotImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  explicit NTPBackgroundImagesCache(size_t max_size_in_bytes);
+  ~NTPBackgroundImagesCache();
+
+  NTPBackgroundImagesCache(const NTPBackgroundImagesCache&) = delete;
+  NTPBackgroundImagesCache& operator=(
+      const NTPBackgroundImagesCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file|. The callback gets null
+  // bytes if the file can't be read. Concurrent requests of the same file
+  // share one disk read.
+  void GetImage(const base::FilePath& image_file, GotImageCallback callback);
+
+  // Reads |image_file| into the cache ahead of its request.
+  void Prefetch(const base::FilePath& image_file);
+
+  // Drops all cached images. Reads in flight are not cached when done.
+  void Clear();
+
+  size_t size_in_bytes() const { return size_in_bytes_; }
+  int disk_reads_count() const { return disk_reads_count_; }
+
+ private:
+  using ImagesCache =
+      base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>;
+
+  void OnGotImageFile(const base::FilePath& image_file,
+                      int generation,
+                      base::Optional<std::string> input);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  const size_t max_size_in_bytes_;
+  size_t size_in_bytes_ = 0;
+  int disk_reads_count_ = 0;
+  // Incremented by Clear() to ignore reads started before it.
+  int generation_ = 0;
+  ImagesCache images_;
+  std::map<base::FilePath, std::vector<GotImageCallback>> pending_callbacks_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  base::WeakPtrFactory<NTPBackgroundImagesCache> weak_factory_;
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
@@ -0,0 +1,112 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class NTPBackgroundImagesCacheTest : public testing::Test {
+ public:
+  NTPBackgroundImagesCacheTest() : cache_(10) {}
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_EQ(static_cast<int>(contents.size()),
+              base::WriteFile(path, contents.data(), contents.size()));
+    return path;
+  }
+
+  std::string GetImage(const base::FilePath& path) {
+    std::string result;
+    cache_.GetImage(path, base::BindOnce(
+                              [](std::string* result,
+                                 scoped_refptr<base::RefCountedMemory> bytes) {
+                                if (bytes)
+                                  result->assign(bytes->front_as<char>(),
+                                                 bytes->size());
+                              },
+                              &result));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  NTPBackgroundImagesCache cache_;
+};
+
+TEST_F(NTPBackgroundImagesCacheTest, ServesCachedImage) {
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+  EXPECT_EQ("image", GetImage(path));
+  EXPECT_EQ("image", GetImage(path));
+  EXPECT_EQ(1, cache_.disk_reads_count());
+  EXPECT_EQ(5u, cache_.size_in_bytes());
+
+  // Missing files are not cached.
+  const base::FilePath missing = temp_dir_.GetPath().AppendASCII("none.jpg");
+  EXPECT_EQ(std::string(), GetImage(missing));
+  EXPECT_EQ(std::string(), GetImage(missing));
+  EXPECT_EQ(3, cache_.disk_reads_count());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, EvictsLeastRecentlyUsed) {
+  const base::FilePath first = WriteImage("first.jpg", "aaaa");
+  const base::FilePath second = WriteImage("second.jpg", "bbbb");
+  const base::FilePath third = WriteImage("third.jpg", "cccc");
+  cache_.Prefetch(first);
+  cache_.Prefetch(second);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, cache_.disk_reads_count());
+
+  // Touch the first image so the second one is evicted by the third.
+  EXPECT_EQ("aaaa", GetImage(first));
+  EXPECT_EQ("cccc", GetImage(third));
+  EXPECT_EQ(3, cache_.disk_reads_count());
+  EXPECT_EQ(8u, cache_.size_in_bytes());
+  EXPECT_EQ("aaaa", GetImage(first));
+  EXPECT_EQ(3, cache_.disk_reads_count());
+  EXPECT_EQ("bbbb", GetImage(second));
+  EXPECT_EQ(4, cache_.disk_reads_count());
+
+  // Images bigger than the cache are served but not kept.
+  const base::FilePath big = WriteImage("big.jpg", "0123456789abc");
+  EXPECT_EQ("0123456789abc", GetImage(big));
+  EXPECT_EQ(8u, cache_.size_in_bytes());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ClearsOnMemoryPressure) {
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+  EXPECT_EQ("image", GetImage(path));
+  EXPECT_EQ(5u, cache_.size_in_bytes());
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(0u, cache_.size_in_bytes());
+  EXPECT_EQ("image", GetImage(path));
+  EXPECT_EQ(2, cache_.disk_reads_count());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, DoesNotCacheReadsStartedBeforeClear) {
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+  cache_.Prefetch(path);
+  cache_.Clear();
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(0u, cache_.size_in_bytes());
+}
+
+}  // namespace ntp_background_images
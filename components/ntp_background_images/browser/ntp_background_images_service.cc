@@ -40,6 +40,8 @@ namespace ntp_background_images {
 namespace {
 
 constexpr int kSIComponentUpdateCheckIntervalHours = 1;
+// Fits a few wallpapers along with the logo and top site favicons.
+constexpr size_t kImageCacheMaxSizeInBytes = 16 * 1024 * 1024;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
 
@@ -133,6 +135,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
       local_pref_(local_pref),
       super_referral_cache_dir_(
           user_data_dir.AppendASCII("SuperReferralCache")),
+      image_cache_(kImageCacheMaxSizeInBytes),
       weak_factory_(this) {
 }
 
@@ -480,6 +483,9 @@ void NTPBackgroundImagesService::OnComponentReady(
 void NTPBackgroundImagesService::OnGetComponentJsonData(
     bool is_super_referral,
     const std::string& json_string) {
+  // Cached images can belong to the previous version of the component.
+  image_cache_.Clear();
+
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
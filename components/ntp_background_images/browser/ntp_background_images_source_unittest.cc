@@ -6,18 +6,45 @@
 #include <memory>
 #include <string>
 
-#include "base/test/task_environment.h"
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_source.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
 #include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 namespace ntp_background_images {
 
+namespace {
+
+constexpr char kTestJsonString[] = R"(
+    {
+      "schemaVersion": 1,
+      "logo": {
+        "imageUrl": "logo.png",
+        "alt": "Technikke: For music lovers",
+        "companyName": "Technikke",
+        "destinationUrl": "https://www.brave.com/?from-super-referreer-demo"
+      },
+      "wallpapers": [
+        {
+          "imageUrl": "background-1.jpg",
+          "focalPoint": { "x": 3988, "y": 2049}
+        }
+      ]
+    })";
+
+}  // namespace
+
 class NTPBackgroundImagesSourceTest : public testing::Test {
  public:
   NTPBackgroundImagesSourceTest() {}
@@ -33,7 +60,38 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  // Sets up sponsored images component data which is installed to a temp
+  // directory with |wallpaper| as its only wallpaper.
+  void InstallComponent(const std::string& wallpaper) {
+    if (!installed_dir_.IsValid())
+      ASSERT_TRUE(installed_dir_.CreateUniqueTempDir());
+    ASSERT_EQ(static_cast<int>(wallpaper.size()),
+              base::WriteFile(
+                  installed_dir_.GetPath().AppendASCII("background-1.jpg"),
+                  wallpaper.data(), wallpaper.size()));
+    service_->si_installed_dir_ = installed_dir_.GetPath();
+    service_->OnGetComponentJsonData(false, kTestJsonString);
+  }
+
+  // Requests the first wallpaper the way the NTP does.
+  void RequestWallpaper() {
+    source_->StartDataRequest(
+        GURL("chrome://branded-wallpaper/sponsored-images/wallpaper-0.jpg"),
+        content::WebContents::Getter(),
+        base::BindOnce(&NTPBackgroundImagesSourceTest::OnGotData,
+                       base::Unretained(this)));
+  }
+
+  void OnGotData(scoped_refptr<base::RefCountedMemory> bytes) {
+    ASSERT_TRUE(bytes);
+    served_count_++;
+    last_served_data_.assign(bytes->front_as<char>(), bytes->size());
+  }
+
+  content::BrowserTaskEnvironment task_environment;
+  base::ScopedTempDir installed_dir_;
+  int served_count_ = 0;
+  std::string last_served_data_;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -79,6 +137,43 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, ReadsImageOnceForRapidOpens) {
+  InstallComponent("wallpaper");
+  auto* image_cache = service_->image_cache();
+
+  // Requests of many tabs opened at once share one read.
+  const int kTabsCount = 50;
+  for (int i = 0; i < kTabsCount; ++i)
+    RequestWallpaper();
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(kTabsCount, served_count_);
+  EXPECT_EQ(1, image_cache->disk_reads_count());
+
+  // Later tabs are served from memory.
+  for (int i = 0; i < kTabsCount; ++i) {
+    RequestWallpaper();
+    task_environment.RunUntilIdle();
+  }
+  EXPECT_EQ(2 * kTabsCount, served_count_);
+  EXPECT_EQ(1, image_cache->disk_reads_count());
+  EXPECT_EQ("wallpaper", last_served_data_);
+}
+
+TEST_F(NTPBackgroundImagesSourceTest, InvalidatesCacheOnComponentUpdate) {
+  InstallComponent("first");
+  RequestWallpaper();
+  task_environment.RunUntilIdle();
+  EXPECT_EQ("first", last_served_data_);
+  EXPECT_EQ(1, service_->image_cache()->disk_reads_count());
+
+  InstallComponent("second");
+  EXPECT_EQ(0u, service_->image_cache()->size_in_bytes());
+  RequestWallpaper();
+  task_environment.RunUntilIdle();
+  EXPECT_EQ("second", last_served_data_);
+  EXPECT_EQ(2, service_->image_cache()->disk_reads_count());
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
@@ -131,6 +131,7 @@ void ViewCounterService::OnUpdated(NTPBackgroundImagesData* data) {
     model_.ResetCurrentWallpaperImageIndex();
     model_.set_total_image_count(data->backgrounds.size());
     model_.set_ignore_count_to_branded_wallpaper(data->IsSuperReferral());
+    PrefetchNextWallpaper();
   }
 }
 
@@ -163,9 +164,23 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    PrefetchNextWallpaper();
   }
 }
 
+void ViewCounterService::PrefetchNextWallpaper() {
+  if (!IsBrandedWallpaperActive())
+    return;
+
+  // The model has already picked the image for the next branded view, so
+  // read it before the NTP asks for it.
+  auto* data = GetCurrentBrandedWallpaperData();
+  auto* image_cache = service_->image_cache();
+  image_cache->Prefetch(
+      data->backgrounds[model_.current_wallpaper_image_index()].image_file);
+  image_cache->Prefetch(data->logo_image_file);
+}
+
 bool ViewCounterService::ShouldShowBrandedWallpaper() const {
   return IsBrandedWallpaperActive() && model_.ShouldShowBrandedWallpaper();
 }
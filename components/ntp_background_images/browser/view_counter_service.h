@@ -85,6 +85,8 @@ class ViewCounterService : public KeyedService,
                            ActiveInitiallyOptedIn);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            ActiveOptedInWithNTPBackgoundOption);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
+                           PrefetchesNextWallpaper);
 
   void OnPreferenceChanged(const std::string& pref_name);
 
@@ -105,6 +107,7 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  void PrefetchNextWallpaper();
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
   PrefService* prefs_ = nullptr;  // not owned
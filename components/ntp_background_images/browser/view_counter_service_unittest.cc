@@ -7,9 +7,12 @@
 #include <string>
 
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/test/task_environment.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/view_counter_service.h"
@@ -91,7 +94,7 @@ class NTPBackgroundImagesViewCounterTest : public testing::Test {
   sync_preferences::TestingPrefServiceSyncable* prefs() { return &prefs_; }
 
  protected:
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<ViewCounterService> view_counter_;
@@ -173,4 +176,36 @@ TEST_F(NTPBackgroundImagesViewCounterTest, ActiveInitiallyOptedIn) {
   EXPECT_TRUE(view_counter_->IsBrandedWallpaperActive());
 }
 
+TEST_F(NTPBackgroundImagesViewCounterTest, PrefetchesNextWallpaper) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  auto data = GetDemoWallpaper(false);
+  data->logo_image_file = temp_dir.GetPath().AppendASCII("logo.png");
+  ASSERT_EQ(4, base::WriteFile(data->logo_image_file, "logo", 4));
+  for (auto& background : data->backgrounds) {
+    background.image_file = temp_dir.GetPath().Append(background.image_file);
+    ASSERT_EQ(9, base::WriteFile(background.image_file, "wallpaper", 9));
+  }
+  service_->si_images_data_ = std::move(data);
+  auto* image_cache = service_->image_cache();
+
+  // First wallpaper and logo are read as soon as data is available.
+  view_counter_->OnUpdated(service_->si_images_data_.get());
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(2, image_cache->disk_reads_count());
+  EXPECT_EQ(13u, image_cache->size_in_bytes());
+
+  // The first view shows the already read wallpaper.
+  view_counter_->RegisterPageView();
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(2, image_cache->disk_reads_count());
+
+  // The model moves on to the second wallpaper which is read right away.
+  view_counter_->RegisterPageView();
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(1, view_counter_->model_.current_wallpaper_image_index());
+  EXPECT_EQ(3, image_cache->disk_reads_count());
+  EXPECT_EQ(22u, image_cache->size_in_bytes());
+}
+
 }  // namespace ntp_background_images
@@ -0,0 +1,80 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_match_index.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+
+SiteMatchIndex::SiteMatchIndex(const std::vector<std::string>& entries,
+                               bool prefixes_only) {
+  entries_.reserve(entries.size());
+  for (const std::string& entry : entries)
+    entries_.push_back(base::ToLowerASCII(entry));
+
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const size_t positions = prefixes_only ? 1 : entries_[i].length();
+    for (size_t position = 0; position < positions; ++position) {
+      suffixes_.push_back(
+          {static_cast<uint32_t>(i), static_cast<uint32_t>(position)});
+    }
+  }
+
+  std::sort(suffixes_.begin(), suffixes_.end(),
+            [this](const Suffix& a, const Suffix& b) {
+              return GetSuffixText(a) < GetSuffixText(b);
+            });
+}
+
+SiteMatchIndex::~SiteMatchIndex() = default;
+
+std::vector<SiteMatchIndex::Match> SiteMatchIndex::FindMatches(
+    base::StringPiece text) const {
+  // Suffixes are compared by their first |text.length()| chars only, so
+  // every suffix starting with |text| falls into one range.
+  const size_t length = text.length();
+  const auto begin = std::lower_bound(
+      suffixes_.begin(), suffixes_.end(), text,
+      [this, length](const Suffix& suffix, base::StringPiece value) {
+        return GetSuffixText(suffix).substr(0, length) < value;
+      });
+  const auto end = std::upper_bound(
+      begin, suffixes_.end(), text,
+      [this, length](base::StringPiece value, const Suffix& suffix) {
+        return value < GetSuffixText(suffix).substr(0, length);
+      });
+
+  std::vector<Match> matches;
+  for (auto it = begin; it != end; ++it) {
+    const std::string& entry = entries_[it->index];
+    const size_t position = it->position;
+    matches.push_back(
+        {it->index, position,
+         position == 0 || !base::IsAsciiAlphaNumeric(entry[position - 1])});
+  }
+
+  // Order by entry and keep the best occurrence of each one.
+  std::sort(matches.begin(), matches.end(),
+            [](const Match& a, const Match& b) {
+              return std::make_tuple(a.index, !a.at_word_boundary,
+                                     a.position) <
+                     std::make_tuple(b.index, !b.at_word_boundary,
+                                     b.position);
+            });
+  matches.erase(std::unique(matches.begin(), matches.end(),
+                            [](const Match& a, const Match& b) {
+                              return a.index == b.index;
+                            }),
+                matches.end());
+  return matches;
+}
+
+base::StringPiece SiteMatchIndex::GetSuffixText(const Suffix& suffix) const {
+  DCHECK_LT(suffix.index, entries_.size());
+  return base::StringPiece(entries_[suffix.index]).substr(suffix.position);
+}
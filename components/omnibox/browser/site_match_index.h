@@ -0,0 +1,57 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+// Finds the entries of a fixed list of sites which contain typed text.
+// The list is compiled once into a sorted array of its normalized suffixes,
+// so every keystroke costs a binary search instead of a scan of the list.
+class SiteMatchIndex {
+ public:
+  struct Match {
+    // Position of the entry in the indexed list.
+    size_t index;
+    // Where the text was found within the entry.
+    size_t position;
+    // Whether the text starts the entry or follows a non-alphanumeric char.
+    bool at_word_boundary;
+  };
+
+  // When |prefixes_only| is set only the text entries start with is matched.
+  SiteMatchIndex(const std::vector<std::string>& entries, bool prefixes_only);
+  ~SiteMatchIndex();
+
+  // Returns the entries containing |text| in the order of the indexed list.
+  // If an entry contains |text| more than once, the first occurrence at a
+  // word boundary is reported, or the first one if there is no such.
+  std::vector<Match> FindMatches(base::StringPiece text) const;
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Suffix {
+    uint32_t index;
+    uint32_t position;
+  };
+
+  base::StringPiece GetSuffixText(const Suffix& suffix) const;
+
+  std::vector<std::string> entries_;
+  std::vector<Suffix> suffixes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SiteMatchIndex);
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
@@ -0,0 +1,157 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_match_index.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SiteMatchIndexTest.*
+
+namespace {
+
+const std::vector<std::string> kSites = {
+    "google.com",      "gmail.com",         "mail.google.com",
+    "maps.google.com", "facebook.com",      "youtube.com",
+    "yahoo.com",       "wikipedia.org",     "amazon.com",
+    "twitter.com",     "live.com",          "instagram.com",
+    "reddit.com",      "linkedin.com",      "ebay.com",
+    "bing.com",        "hotmail.com",       "stackoverflow.com",
+    "yandex.ru",       "news.ycombinator.com",
+};
+
+// Entries containing |text| the way the providers used to find them.
+std::set<size_t> FindBySubstringSearch(const std::vector<std::string>& entries,
+                                       const std::string& text,
+                                       bool prefixes_only) {
+  std::set<size_t> result;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const size_t pos = entries[i].find(text);
+    if (pos != std::string::npos && (!prefixes_only || pos == 0))
+      result.insert(i);
+  }
+  return result;
+}
+
+std::set<size_t> GetIndexes(const std::vector<SiteMatchIndex::Match>& matches) {
+  std::set<size_t> result;
+  for (const auto& match : matches)
+    result.insert(match.index);
+  return result;
+}
+
+// Every partial input a user can type while going for one of |entries|, plus
+// some that match nothing.
+std::vector<std::string> GetPartialInputs(
+    const std::vector<std::string>& entries) {
+  std::vector<std::string> inputs = {"", "zzz", "xn--", "тест", ".com.",
+                                     "google.com.evil"};
+  for (const std::string& entry : entries) {
+    for (size_t begin = 0; begin < entry.length(); ++begin) {
+      for (size_t length = 1; begin + length <= entry.length(); ++length)
+        inputs.push_back(entry.substr(begin, length));
+    }
+  }
+  return inputs;
+}
+
+}  // namespace
+
+TEST(SiteMatchIndexTest, MatchesSameEntriesAsSubstringSearch) {
+  const SiteMatchIndex index(kSites, false);
+  for (const std::string& input : GetPartialInputs(kSites)) {
+    const auto matches = index.FindMatches(input);
+    EXPECT_EQ(FindBySubstringSearch(kSites, input, false), GetIndexes(matches))
+        << input;
+    for (size_t i = 0; i < matches.size(); ++i) {
+      const auto& match = matches[i];
+      EXPECT_EQ(match.position, kSites[match.index].find(input, match.position))
+          << input;
+      if (i > 0)
+        EXPECT_LT(matches[i - 1].index, match.index) << input;
+    }
+  }
+}
+
+TEST(SiteMatchIndexTest, MatchesSameEntriesAsPrefixSearch) {
+  const SiteMatchIndex index(kSites, true);
+  for (const std::string& input : GetPartialInputs(kSites)) {
+    const auto matches = index.FindMatches(input);
+    EXPECT_EQ(FindBySubstringSearch(kSites, input, true), GetIndexes(matches))
+        << input;
+    for (const auto& match : matches) {
+      EXPECT_EQ(0u, match.position);
+      EXPECT_TRUE(match.at_word_boundary);
+    }
+  }
+}
+
+TEST(SiteMatchIndexTest, ReportsWordBoundaryOccurrence) {
+  const SiteMatchIndex index({"gmail.com", "mail.google.com", "hotmail.mail.ru",
+                              "MAIL.RU"},
+                             false);
+  const auto matches = index.FindMatches("mail");
+  ASSERT_EQ(4u, matches.size());
+
+  EXPECT_EQ(1u, matches[0].position);
+  EXPECT_FALSE(matches[0].at_word_boundary);
+  EXPECT_EQ(0u, matches[1].position);
+  EXPECT_TRUE(matches[1].at_word_boundary);
+  // The second occurrence starts a word.
+  EXPECT_EQ(8u, matches[2].position);
+  EXPECT_TRUE(matches[2].at_word_boundary);
+  // Entries are normalized to lower case.
+  EXPECT_EQ(3u, matches[3].index);
+  EXPECT_EQ(0u, matches[3].position);
+}
+
+TEST(SiteMatchIndexTest, KeystrokesOnLargeList) {
+  const size_t kEntriesCount = 10000;
+  std::vector<std::string> entries;
+  for (size_t i = 0; i < kEntriesCount; ++i) {
+    entries.push_back(kSites[i % kSites.size()].substr(0, 4 + i % 5) +
+                      base::NumberToString(i * 7919 % kEntriesCount) + "." +
+                      kSites[(i / kSites.size()) % kSites.size()]);
+  }
+
+  const base::TimeTicks build_start = base::TimeTicks::Now();
+  const SiteMatchIndex index(entries, false);
+  const base::TimeDelta build_time = base::TimeTicks::Now() - build_start;
+
+  // Type a few sites char by char.
+  std::vector<std::string> keystrokes;
+  for (const char* site : {"stackoverflow.com", "news.ycombinator", "gma",
+                           "wiki", "4242.yandex.ru"}) {
+    const std::string text(site);
+    for (size_t length = 1; length <= text.length(); ++length)
+      keystrokes.push_back(text.substr(0, length));
+  }
+
+  base::TimeDelta index_time;
+  base::TimeDelta scan_time;
+  for (const std::string& keystroke : keystrokes) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    const auto matches = index.FindMatches(keystroke);
+    index_time += base::TimeTicks::Now() - start;
+
+    start = base::TimeTicks::Now();
+    const auto expected = FindBySubstringSearch(entries, keystroke, false);
+    scan_time += base::TimeTicks::Now() - start;
+
+    EXPECT_EQ(expected, GetIndexes(matches)) << keystroke;
+  }
+
+  LOG(INFO) << kEntriesCount << " entries indexed in "
+            << build_time.InMicroseconds() << "us, " << keystrokes.size()
+            << " keystrokes took " << index_time.InMicroseconds()
+            << "us with the index and " << scan_time.InMicroseconds()
+            << "us with a scan";
+}
@@ -8,8 +8,10 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/omnibox/browser/site_match_index.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/autocomplete_provider_client.h"
 #include "components/prefs/pref_service.h"
@@ -47,34 +49,44 @@ void SuggestedSitesProvider::Start(const AutocompleteInput& input,
         match.match_string_.length() != input_text.length()) {
       return;
     }
-    size_t foundPos = match.match_string_.find(input_text);
-    // We'd normally check for npos here but we want only people that
-    // really want these suggestions. Example don't suggest bitcoin and
-    // litecoin for just a coin search.
-    if (foundPos == 0) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text,
-              base::UTF16ToASCII(match.display_));
-      AddMatch(match, styles);
-      if (match.allow_default_ &&
-          match.match_string_.length() == input_text.length()) {
-        // It's guaranteed that matches_ has at least 1 item
-        // here because of the previous AddMatch call.
-        size_t last_index = matches_.size() - 1;
-        matches_[last_index].SetAllowedToBeDefault(input);
-        // As from autocomplete_provider.h:
-        // Search Primary Provider (what you typed) | 1300
-        matches_[last_index].relevance = 1301;
-      }
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text,
+            base::UTF16ToASCII(match.display_));
+    AddMatch(match, styles);
+    if (match.allow_default_ &&
+        match.match_string_.length() == input_text.length()) {
+      // It's guaranteed that matches_ has at least 1 item
+      // here because of the previous AddMatch call.
+      size_t last_index = matches_.size() - 1;
+      matches_[last_index].SetAllowedToBeDefault(input);
+      // As from autocomplete_provider.h:
+      // Search Primary Provider (what you typed) | 1300
+      matches_[last_index].relevance = 1301;
     }
   };
 
-  std::for_each(suggested_sites_.begin(), suggested_sites_.end(),
-      check_add_match);
+  // The index only has prefixes, since we want only people that really want
+  // these suggestions. Example don't suggest bitcoin and litecoin for just a
+  // coin search.
+  for (const auto& found : GetIndex().FindMatches(input_text))
+    check_add_match(suggested_sites_[found.index]);
 }
 
 SuggestedSitesProvider::~SuggestedSitesProvider() {}
 
+// static
+const SiteMatchIndex& SuggestedSitesProvider::GetIndex() {
+  static const base::NoDestructor<SiteMatchIndex> index(
+      [] {
+        std::vector<std::string> match_strings;
+        for (const auto& match : suggested_sites_)
+          match_strings.push_back(match.match_string_);
+        return match_strings;
+      }(),
+      true);
+  return *index;
+}
+
 // static
 ACMatchClassifications SuggestedSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
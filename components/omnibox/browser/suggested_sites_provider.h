@@ -17,6 +17,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class SiteMatchIndex;
 
 // This is the provider for Brave Suggested Sites
 class SuggestedSitesProvider : public AutocompleteProvider {
@@ -30,6 +31,10 @@ class SuggestedSitesProvider : public AutocompleteProvider {
   ~SuggestedSitesProvider() override;
   static std::vector<SuggestedSitesMatch> suggested_sites_;
 
+  // Returns match strings of |suggested_sites_| compiled for prefix matching
+  // on the first use.
+  static const SiteMatchIndex& GetIndex();
+
   static const int kRelevance;
 
   void AddMatch(const SuggestedSitesMatch& match,
@@ -10,9 +10,11 @@
 #include <algorithm>
 #include <string>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/omnibox/browser/site_match_index.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/history_provider.h"
 #include "components/prefs/pref_service.h"
@@ -21,6 +23,17 @@
 // Search Secondary Provider (suggestion)                              |  100++
 const int TopSitesProvider::kRelevance = 100;
 
+namespace {
+
+// Sites starting with the input go first, then the ones where the input
+// starts a word. The list order decides within each group.
+int GetMatchRank(const SiteMatchIndex::Match& match) {
+  if (match.position == 0)
+    return 0;
+  return match.at_word_boundary ? 1 : 2;
+}
+
+}  // namespace
 
 TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
     : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH), client_(client) {
@@ -42,16 +55,21 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
+  std::vector<SiteMatchIndex::Match> found =
+      GetIndex().FindMatches(input_text);
+  std::stable_sort(found.begin(), found.end(),
+                   [](const SiteMatchIndex::Match& a,
+                      const SiteMatchIndex::Match& b) {
+                     return GetMatchRank(a) < GetMatchRank(b);
+                   });
+
+  for (std::vector<SiteMatchIndex::Match>::const_iterator i = found.begin();
+       (i != found.end()) && (matches_.size() < provider_max_matches());
        ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+    const std::string &current_site = top_sites_[i->index];
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, i->position);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
@@ -70,6 +88,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+const SiteMatchIndex& TopSitesProvider::GetIndex() {
+  static const base::NoDestructor<SiteMatchIndex> index(top_sites_, false);
+  return *index;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
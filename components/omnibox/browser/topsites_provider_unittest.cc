@@ -56,3 +56,22 @@ TEST_F(TopSitesProviderTest, NoMatchingWhenPrefIsOff) {
   provider_->Start(CreateAutocompleteInput("dex"), false);
   EXPECT_TRUE(provider_->matches().empty());
 }
+
+TEST_F(TopSitesProviderTest, RanksMatchesByPosition) {
+  // "gmail.com" goes before "mail.google.com" in the list, but the input
+  // starts the latter one.
+  provider_->Start(CreateAutocompleteInput("mail"), false);
+  const ACMatches& matches = provider_->matches();
+  ASSERT_GE(matches.size(), 2u);
+  EXPECT_EQ(base::ASCIIToUTF16("mail.google.com"), matches[0].contents);
+  EXPECT_GT(matches[0].relevance, matches[1].relevance);
+
+  // Matches where the input starts a word go before other ones.
+  provider_->Start(CreateAutocompleteInput("google"), false);
+  ASSERT_FALSE(provider_->matches().empty());
+  for (const auto& match : provider_->matches()) {
+    const size_t pos = match.contents.find(base::ASCIIToUTF16("google"));
+    ASSERT_NE(base::string16::npos, pos);
+    EXPECT_TRUE(pos == 0 || match.contents[pos - 1] == '.') << match.contents;
+  }
+}
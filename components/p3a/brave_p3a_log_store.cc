@@ -5,9 +5,13 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -35,10 +39,16 @@ void RecordP3A(uint64_t answers_count) {
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
-                                   PrefService* local_state)
-    : delegate_(delegate), local_state_(local_state) {
+                                   PrefService* local_state,
+                                   base::TimeDelta persist_interval,
+                                   size_t max_batch_size)
+    : delegate_(delegate),
+      local_state_(local_state),
+      persist_interval_(persist_interval),
+      max_batch_size_(max_batch_size) {
   DCHECK(delegate_);
   DCHECK(local_state);
+  DCHECK_GT(max_batch_size_, 0u);
 }
 
 BraveP3ALogStore::~BraveP3ALogStore() = default;
@@ -56,11 +66,23 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
+  // Histograms can be updated many times in a row, so the persistent value is
+  // updated later.
+  pending_entries_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, persist_interval_, this,
+                         &BraveP3ALogStore::PersistPendingValues);
+  }
+}
+
+void BraveP3ALogStore::PersistPendingValues() {
+  persist_timer_.Stop();
+  if (pending_entries_.empty()) {
+    return;
+  }
+
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  WritePendingValues(update.Get());
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
@@ -79,6 +101,7 @@ void BraveP3ALogStore::ResetUploadStamps() {
                       base::Value(pair.second.sent_timestamp.ToDoubleT()));
     }
   }
+  WritePendingValues(update.Get());
 
   RecordP3A(log_.size() - unsent_entries_.size());
 
@@ -94,13 +117,12 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
+  DCHECK(!staged_entry_keys_.empty());
+  DCHECK(log_.find(staged_entry_keys_.front()) != log_.end());
 
   return staged_log_;
 }
@@ -118,14 +140,33 @@ const std::string& BraveP3ALogStore::staged_log_signature() const {
 void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
-  uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
-
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  staged_entry_keys_.assign(unsent_entries_.begin(), unsent_entries_.end());
+
+  // Pick random entries.
+  const size_t count = std::min(max_batch_size_, staged_entry_keys_.size());
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t rand_idx =
+        i + base::RandGenerator(staged_entry_keys_.size() - i);
+    std::swap(staged_entry_keys_[i], staged_entry_keys_[rand_idx]);
+  }
+  staged_entry_keys_.resize(count);
+
+  if (max_batch_size_ == 1) {
+    const std::string& key = staged_entry_keys_.front();
+    DCHECK(!log_.find(key)->second.sent);
+    staged_log_ = delegate_->Serialize(key, log_[key].value);
+  } else {
+    // Every entry keeps its own serialized message.
+    brave_pyxis::RawP3ABatch batch;
+    for (const std::string& key : staged_entry_keys_) {
+      DCHECK(!log_.find(key)->second.sent);
+      batch.add_values(delegate_->Serialize(key, log_[key].value));
+    }
+    staged_log_ = batch.SerializeAsString();
+  }
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << count
+          << " entries, first is " << staged_entry_keys_.front();
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -133,24 +174,27 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  for (const std::string& key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+
+    // Update the persistent value.
+    update->SetPath({log_iter->first, kLogSentKey},
+                    base::Value(log_iter->second.sent));
+    update->SetPath({log_iter->first, kLogTimestampKey},
+                    base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
+  WritePendingValues(update.Get());
 
-  staged_entry_key_.clear();
+  staged_entry_keys_.clear();
   staged_log_.clear();
 }
 
@@ -211,4 +255,16 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
   }
 }
 
+void BraveP3ALogStore::WritePendingValues(base::DictionaryValue* dict) {
+  for (const std::string& name : pending_entries_) {
+    auto iter = log_.find(name);
+    DCHECK(iter != log_.end());
+    dict->SetPath({name, kLogValueKey},
+                  base::Value(base::NumberToString(iter->second.value)));
+    dict->SetPath({name, kLogSentKey}, base::Value(iter->second.sent));
+  }
+  pending_entries_.clear();
+  persist_timer_.Stop();
+}
+
 }  // namespace brave
@@ -7,22 +7,33 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class DictionaryValue;
+}  // namespace base
+
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists in prefs.
+// Value updates are coalesced and persisted at most once per
+// |persist_interval|, sent flags are persisted right away along with any
+// pending values. The owner persists pending values on shutdown.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
+// A staged log holds up to |max_batch_size| entries, several entries are
+// wrapped into |brave_pyxis::RawP3ABatch|.
 class BraveP3ALogStore : public metrics::LogStore {
  public:
   class Delegate {
@@ -35,8 +46,10 @@ class BraveP3ALogStore : public metrics::LogStore {
     virtual ~Delegate() {}
   };
 
-  explicit BraveP3ALogStore(Delegate* delegate,
-                            PrefService* local_state);
+  BraveP3ALogStore(Delegate* delegate,
+                   PrefService* local_state,
+                   base::TimeDelta persist_interval,
+                   size_t max_batch_size);
 
   // TODO(iefremov): Make parent destructor virtual?
   virtual ~BraveP3ALogStore();
@@ -46,6 +59,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   void UpdateValue(const std::string& histogram_name, uint64_t value);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
+  // Persists values which were updated since the last write.
+  void PersistPendingValues();
 
   // metrics::LogStore:
   bool has_unsent_logs() const override;
@@ -80,14 +95,22 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void WritePendingValues(base::DictionaryValue* dict);
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
+  const base::TimeDelta persist_interval_;
+  const size_t max_batch_size_;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
+  // Entries whose values were not persisted yet.
+  base::flat_set<std::string> pending_entries_;
+  base::OneShotTimer persist_timer_;
+
+  std::vector<std::string> staged_entry_keys_;
   std::string staged_log_;
 
   // Not used for now.
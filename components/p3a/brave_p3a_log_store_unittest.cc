@@ -0,0 +1,192 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+constexpr int kPersistIntervalInSeconds = 60;
+
+std::string GetHistogramName(const int index) {
+  return "Brave.Test." + base::NumberToString(index);
+}
+
+class FakeDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public ::testing::Test {
+ protected:
+  BraveP3ALogStoreTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+  }
+
+  ~BraveP3ALogStoreTest() override {}
+
+  void SetUp() override {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    pref_change_registrar_.Init(&local_state_);
+    pref_change_registrar_.Add(
+        kPrefName, base::BindRepeating(&BraveP3ALogStoreTest::OnPrefChanged,
+                                       base::Unretained(this)));
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateLogStore(size_t max_batch_size) {
+    return std::make_unique<BraveP3ALogStore>(
+        &delegate_, &local_state_,
+        base::TimeDelta::FromSeconds(kPersistIntervalInSeconds),
+        max_batch_size);
+  }
+
+  void OnPrefChanged() { pref_writes_++; }
+
+  std::string GetPersistedValue(const std::string& histogram_name) {
+    const base::Value* value = local_state_.GetDictionary(kPrefName)->FindPath(
+        {histogram_name, "value"});
+    return value ? value->GetString() : std::string();
+  }
+
+  bool IsPersistedAsSent(const std::string& histogram_name) {
+    const base::Value* sent = local_state_.GetDictionary(kPrefName)->FindPath(
+        {histogram_name, "sent"});
+    return sent && sent->GetBool();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple local_state_;
+  PrefChangeRegistrar pref_change_registrar_;
+  FakeDelegate delegate_;
+  int pref_writes_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, CoalescesValueUpdates) {
+  auto log_store = CreateLogStore(1);
+  log_store->LoadPersistedUnsentLogs();
+
+  for (int i = 0; i < 1000; i++) {
+    log_store->UpdateValue(GetHistogramName(i % 5), i);
+  }
+  EXPECT_EQ(0, pref_writes_);
+  EXPECT_TRUE(log_store->has_unsent_logs());
+
+  task_environment_.FastForwardBy(
+      base::TimeDelta::FromSeconds(kPersistIntervalInSeconds));
+
+  EXPECT_EQ(1, pref_writes_);
+  EXPECT_EQ("995", GetPersistedValue(GetHistogramName(0)));
+  EXPECT_EQ("999", GetPersistedValue(GetHistogramName(4)));
+
+  // Persisted values are loaded after a restart.
+  log_store = CreateLogStore(1);
+  log_store->LoadPersistedUnsentLogs();
+  EXPECT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ(0u, log_store->staged_log().find("Brave.Test."));
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsValuesOncePerIntervalOverDay) {
+  auto log_store = CreateLogStore(1);
+  log_store->LoadPersistedUnsentLogs();
+
+  // A histogram updated every 10 seconds for a day.
+  const int kUpdateIntervalInSeconds = 10;
+  const int kUpdatesCount = 24 * 60 * 60 / kUpdateIntervalInSeconds;
+  for (int i = 0; i < kUpdatesCount; i++) {
+    log_store->UpdateValue(GetHistogramName(0), i % 7);
+    task_environment_.FastForwardBy(
+        base::TimeDelta::FromSeconds(kUpdateIntervalInSeconds));
+  }
+
+  LOG(INFO) << kUpdatesCount << " updates caused " << pref_writes_
+            << " pref writes";
+  EXPECT_LE(pref_writes_, 24 * 60 * 60 / kPersistIntervalInSeconds);
+
+  log_store->PersistPendingValues();
+  EXPECT_EQ(base::NumberToString((kUpdatesCount - 1) % 7),
+            GetPersistedValue(GetHistogramName(0)));
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsSentFlagsRightAway) {
+  auto log_store = CreateLogStore(1);
+  log_store->LoadPersistedUnsentLogs();
+  log_store->UpdateValue(GetHistogramName(0), 1);
+
+  log_store->StageNextLog();
+  EXPECT_EQ(GetHistogramName(0) + ":1", log_store->staged_log());
+  log_store->DiscardStagedLog();
+
+  // The pending value is written along with the sent flag.
+  EXPECT_EQ(1, pref_writes_);
+  EXPECT_TRUE(IsPersistedAsSent(GetHistogramName(0)));
+  EXPECT_EQ("1", GetPersistedValue(GetHistogramName(0)));
+  EXPECT_FALSE(log_store->has_unsent_logs());
+
+  task_environment_.FastForwardBy(
+      base::TimeDelta::FromSeconds(kPersistIntervalInSeconds));
+  EXPECT_EQ(1, pref_writes_);
+}
+
+TEST_F(BraveP3ALogStoreTest, StagesBatches) {
+  const size_t kBatchSize = 3;
+  const int kHistogramsCount = 5;
+  auto log_store = CreateLogStore(kBatchSize);
+  log_store->LoadPersistedUnsentLogs();
+  for (int i = 0; i < kHistogramsCount; i++) {
+    log_store->UpdateValue(GetHistogramName(i), i);
+  }
+
+  std::set<std::string> sent_values;
+  int batches_count = 0;
+  while (log_store->has_unsent_logs()) {
+    log_store->StageNextLog();
+    brave_pyxis::RawP3ABatch batch;
+    ASSERT_TRUE(batch.ParseFromString(log_store->staged_log()));
+    EXPECT_LE(static_cast<size_t>(batch.values_size()), kBatchSize);
+    for (const std::string& value : batch.values()) {
+      EXPECT_TRUE(sent_values.insert(value).second);
+    }
+    log_store->DiscardStagedLog();
+    batches_count++;
+  }
+
+  EXPECT_EQ(2, batches_count);
+  ASSERT_EQ(static_cast<size_t>(kHistogramsCount), sent_values.size());
+  for (int i = 0; i < kHistogramsCount; i++) {
+    EXPECT_EQ(1u, sent_values.count(delegate_.Serialize(GetHistogramName(i),
+                                                         i)));
+    EXPECT_TRUE(IsPersistedAsSent(GetHistogramName(i)));
+  }
+}
+
+}  // namespace brave
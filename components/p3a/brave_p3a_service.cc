@@ -44,6 +44,9 @@ constexpr char kDefaultUploadServerUrl[] = "https://p3a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Histogram values are written to local state at most once per this interval.
+constexpr uint64_t kLogStorePersistIntervalSeconds = 60;  // 1 minute.
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -137,13 +140,17 @@ void BraveP3AService::Init(
   VLOG(2) << "BraveP3AService parameters are:"
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
+          << ", upload_batch_size_ = " << upload_batch_size_
           << ", upload_server_url_ = " << upload_server_url_.spec()
           << ", rotation_interval_ = " << rotation_interval_;
 
   InitPyxisMeta();
 
   // Init log store.
-  log_store_.reset(new BraveP3ALogStore(this, local_state_));
+  log_store_.reset(new BraveP3ALogStore(
+      this, local_state_,
+      base::TimeDelta::FromSeconds(kLogStorePersistIntervalSeconds),
+      upload_batch_size_));
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
   for (const auto& entry : histogram_values_) {
@@ -166,7 +173,7 @@ void BraveP3AService::Init(
 
   // Init other components.
   uploader_.reset(new BraveP3AUploader(
-      url_loader_factory, upload_server_url_,
+      url_loader_factory, upload_server_url_, upload_batch_size_ > 1,
       base::Bind(&BraveP3AService::OnLogUploadComplete, this)));
 
   upload_scheduler_.reset(new BraveP3AScheduler(
@@ -183,6 +190,12 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::OnShutdown() {
+  if (log_store_) {
+    log_store_->PersistPendingValues();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) const {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -227,6 +240,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     randomize_upload_interval_ = false;
   }
 
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string batch_size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t batch_size;
+    if (base::StringToSizeT(batch_size_str, &batch_size) && batch_size > 0) {
+      upload_batch_size_ = batch_size;
+    }
+  }
+
   if (cmdline->HasSwitch(switches::kP3ARotationIntervalSeconds)) {
     std::string seconds_str =
         cmdline->GetSwitchValueASCII(switches::kP3ARotationIntervalSeconds);
@@ -0,0 +1,229 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_service.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/scoped_command_line.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
+#include "brave/components/p3a/brave_p3a_switches.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3AServiceTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr const char* kRecordedHistograms[] = {
+    "Brave.Core.BookmarksCountOnProfileLoad.2",
+    "Brave.Core.IsDefault",
+    "Brave.Core.LastTimeIncognitoUsed",
+    "Brave.Core.NumberOfExtensions",
+    "Brave.Core.TabCount",
+    "Brave.Core.TorEverUsed",
+    "Brave.Core.WindowCount.2",
+    "Brave.Importer.ImporterSource",
+    "Brave.Omnibox.SearchCount",
+    "Brave.Uptime.BrowserOpenMinutes",
+};
+
+constexpr int kRecordIntervalInSeconds = 10;
+constexpr int kDayInSeconds = 24 * 60 * 60;
+
+}  // namespace
+
+class BraveP3AServiceTest : public ::testing::Test {
+ protected:
+  BraveP3AServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &test_url_loader_factory_)) {}
+
+  ~BraveP3AServiceTest() override {}
+
+  void SetUp() override {
+    statistics_recorder_ =
+        base::StatisticsRecorder::CreateTemporaryForTesting();
+
+    BraveP3AService::RegisterPrefs(local_state_.registry(), true);
+    local_state_.registry()->RegisterStringPref(kWeekOfInstallation,
+                                                std::string());
+    local_state_.registry()->RegisterStringPref(kReferralPromoCode,
+                                                std::string());
+
+    pref_change_registrar_.Init(&local_state_);
+    pref_change_registrar_.Add(
+        "p3a.logs",
+        base::BindLambdaForTesting([this]() { pref_writes_++; }));
+
+    // Stand-in for the P3A server which accepts every upload
+    test_url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [this](const network::ResourceRequest& request) {
+          OnRequest(request);
+        }));
+
+    base::CommandLine* command_line =
+        scoped_command_line_.GetProcessCommandLine();
+    command_line->AppendSwitch(switches::kP3ADoNotRandomizeUploadInterval);
+    command_line->AppendSwitchASCII(switches::kP3ARotationIntervalSeconds,
+                                    base::NumberToString(7 * kDayInSeconds));
+  }
+
+  void TearDown() override {
+    service_.reset();
+    statistics_recorder_.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  void SetBatchSize(const size_t batch_size) {
+    scoped_command_line_.GetProcessCommandLine()->AppendSwitchASCII(
+        switches::kP3AUploadBatchSize, base::NumberToString(batch_size));
+  }
+
+  void CreateService() {
+    service_ = base::MakeRefCounted<BraveP3AService>(&local_state_);
+    service_->InitCallbacks();
+    service_->Init(shared_url_loader_factory_);
+  }
+
+  void OnRequest(const network::ResourceRequest& request) {
+    requests_++;
+    batched_ = request.headers.HasHeader("X-Brave-P3A-Batch");
+
+    ASSERT_TRUE(request.request_body);
+    ASSERT_EQ(1u, request.request_body->elements()->size());
+    const network::DataElement& element =
+        request.request_body->elements()->at(0);
+    std::string body;
+    ASSERT_TRUE(base::Base64Decode(
+        std::string(element.bytes(), element.length()), &body));
+
+    std::vector<std::string> values;
+    if (batched_) {
+      brave_pyxis::RawP3ABatch batch;
+      ASSERT_TRUE(batch.ParseFromString(body));
+      values.assign(batch.values().begin(), batch.values().end());
+    } else {
+      values.push_back(body);
+    }
+
+    // Every value keeps its own encoding
+    for (const std::string& value : values) {
+      brave_pyxis::RawP3AValue message;
+      ASSERT_TRUE(message.ParseFromString(value));
+      EXPECT_TRUE(uploaded_metric_ids_.insert(message.metric_id()).second);
+    }
+
+    test_url_loader_factory_.AddResponse(request.url.spec(), std::string());
+  }
+
+  void SimulateDay() {
+    for (int i = 0; i < kDayInSeconds / kRecordIntervalInSeconds; i++) {
+      for (const char* histogram_name : kRecordedHistograms) {
+        base::UmaHistogramExactLinear(histogram_name, i % 7, 8);
+        samples_++;
+      }
+      task_environment_.FastForwardBy(
+          base::TimeDelta::FromSeconds(kRecordIntervalInSeconds));
+    }
+  }
+
+  size_t GetStoredMetricsCount() {
+    return local_state_.GetDictionary("p3a.logs")->DictSize();
+  }
+
+  std::string GetStoredValue(const std::string& histogram_name) {
+    const base::Value* value = local_state_.GetDictionary("p3a.logs")->FindPath(
+        {histogram_name, "value"});
+    return value ? value->GetString() : std::string();
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  base::test::ScopedCommandLine scoped_command_line_;
+  std::unique_ptr<base::StatisticsRecorder> statistics_recorder_;
+  TestingPrefServiceSimple local_state_;
+  PrefChangeRegistrar pref_change_registrar_;
+  network::TestURLLoaderFactory test_url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  scoped_refptr<BraveP3AService> service_;
+
+  int samples_ = 0;
+  int pref_writes_ = 0;
+  int requests_ = 0;
+  bool batched_ = false;
+  std::set<uint64_t> uploaded_metric_ids_;
+};
+
+TEST_F(BraveP3AServiceTest, UploadsEveryMetricSeparately) {
+  CreateService();
+  SimulateDay();
+
+  LOG(INFO) << samples_ << " samples caused " << pref_writes_
+            << " pref writes and " << requests_ << " requests";
+  EXPECT_FALSE(batched_);
+  EXPECT_LT(pref_writes_, samples_ / 10);
+  EXPECT_EQ(GetStoredMetricsCount(), uploaded_metric_ids_.size());
+  EXPECT_EQ(static_cast<int>(uploaded_metric_ids_.size()), requests_);
+  for (const char* histogram_name : kRecordedHistograms) {
+    EXPECT_EQ(1u,
+              uploaded_metric_ids_.count(base::HashMetricName(histogram_name)));
+  }
+}
+
+TEST_F(BraveP3AServiceTest, UploadsBatches) {
+  const size_t kBatchSize = 5;
+  SetBatchSize(kBatchSize);
+  CreateService();
+  SimulateDay();
+
+  LOG(INFO) << samples_ << " samples caused " << pref_writes_
+            << " pref writes and " << requests_ << " requests";
+  EXPECT_TRUE(batched_);
+  EXPECT_LT(pref_writes_, samples_ / 10);
+  EXPECT_EQ(GetStoredMetricsCount(), uploaded_metric_ids_.size());
+  EXPECT_EQ(
+      static_cast<int>((uploaded_metric_ids_.size() + kBatchSize - 1) /
+                       kBatchSize),
+      requests_);
+  for (const char* histogram_name : kRecordedHistograms) {
+    EXPECT_EQ(1u,
+              uploaded_metric_ids_.count(base::HashMetricName(histogram_name)));
+  }
+}
+
+TEST_F(BraveP3AServiceTest, PersistsPendingValuesOnShutdown) {
+  CreateService();
+  base::UmaHistogramExactLinear(kRecordedHistograms[0], 3, 8);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(std::string(), GetStoredValue(kRecordedHistograms[0]));
+
+  // Shut down before the value would be persisted by the log store.
+  service_->OnShutdown();
+
+  EXPECT_EQ("3", GetStoredValue(kRecordedHistograms[0]));
+}
+
+}  // namespace brave
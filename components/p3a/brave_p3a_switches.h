@@ -19,6 +19,10 @@ constexpr char kP3ADoNotRandomizeUploadInterval[] =
 // Interval between restarting the uploading process for all gathered values.
 constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 
+// Maximum number of values sent in one request, values are sent one by one
+// by default.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
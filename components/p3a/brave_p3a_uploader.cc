@@ -44,9 +44,11 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotation() {
 BraveP3AUploader::BraveP3AUploader(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
     const GURL server_url,
+    bool batched,
     const MetricsLogUploader::UploadCallback& on_upload_complete)
     : url_loader_factory_(url_loader_factory),
       server_url_(server_url),
+      batched_(batched),
       on_upload_complete_(on_upload_complete) {}
 
 BraveP3AUploader::~BraveP3AUploader() = default;
@@ -60,6 +62,9 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   resource_request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   resource_request->method = "POST";
   resource_request->headers.SetHeader("X-Brave-P3A", "?1");
+  if (batched_) {
+    resource_request->headers.SetHeader("X-Brave-P3A-Batch", "?1");
+  }
 
   url_loader_ = network::SimpleURLLoader::Create(std::move(resource_request),
                                                  GetNetworkTrafficAnnotation());
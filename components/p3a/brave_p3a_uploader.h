@@ -21,9 +21,12 @@ namespace brave {
 
 class BraveP3AUploader : public metrics::MetricsLogUploader {
  public:
+  // |batched| tells the server that logs are |brave_pyxis::RawP3ABatch|
+  // messages.
   BraveP3AUploader(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
       const GURL server_url,
+      bool batched,
       const MetricsLogUploader::UploadCallback& on_upload_complete);
 
   ~BraveP3AUploader() override;
@@ -39,6 +42,7 @@ class BraveP3AUploader : public metrics::MetricsLogUploader {
  private:
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   const GURL server_url_;
+  const bool batched_;
   const MetricsLogUploader::UploadCallback on_upload_complete_;
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   DISALLOW_COPY_AND_ASSIGN(BraveP3AUploader);
@@ -24,6 +24,7 @@
 #include "base/task/post_task.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "brave/common/tor/tor_constants.h"
 
 #if defined(OS_POSIX)
 int pipehack[2];
@@ -128,16 +129,20 @@ void TorLauncherImpl::Launch(const TorConfig& config,
   if (!tor_watch_path.empty()) {
     if (!base::DirectoryExists(tor_watch_path))
       base::CreateDirectory(tor_watch_path);
+    // Files left by a previous tor would point the control client to a dead
+    // port until the new ones are written.
+    base::DeleteFile(tor_watch_path.Append(kTorControlPortFile), false);
+    base::DeleteFile(tor_watch_path.Append(kTorControlCookieFile), false);
     args.AppendArg("--pidfile");
     args.AppendArgPath(tor_watch_path.AppendASCII("tor.pid"));
     args.AppendArg("--controlport");
     args.AppendArg("auto");
     args.AppendArg("--controlportwritetofile");
-    args.AppendArgPath(tor_watch_path.AppendASCII("controlport"));
+    args.AppendArgPath(tor_watch_path.Append(kTorControlPortFile));
     args.AppendArg("--cookieauthentication");
     args.AppendArg("1");
     args.AppendArg("--cookieauthfile");
-    args.AppendArgPath(tor_watch_path.AppendASCII("control_auth_cookie"));
+    args.AppendArgPath(tor_watch_path.Append(kTorControlCookieFile));
   }
 
   base::LaunchOptions launchopts;
@@ -149,7 +154,8 @@ void TorLauncherImpl::Launch(const TorConfig& config,
 #endif
   tor_process_ = base::LaunchProcess(args, launchopts);
 
-  // TODO(darkdh): return success when tor connected to tor network
+  // Connection to the tor network is reported by the control port client in
+  // the browser, see TorControl.
   bool result = tor_process_.IsValid();
 
   if (callback)
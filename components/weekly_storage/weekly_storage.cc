@@ -5,19 +5,20 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
 #include <utility>
 
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
 #include "components/prefs/pref_service.h"
-#include "components/prefs/scoped_user_pref_update.h"
 
 namespace {
-constexpr size_t kDaysInWeek = 7;
+// Frequently updated values are saved at most once per this interval.
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(30);
 }
 
+constexpr size_t WeeklyStorage::kDaysInWeek;
+
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
       pref_name_(pref_name),
@@ -37,83 +38,112 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+  if (days_count_ > 0) {
+    last_saved_midnight = daily_values_[last_day_].day;
   }
 
   if (now_midnight - last_saved_midnight > base::TimeDelta()) {
     // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, delta});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
+    // save it with a new timestamp. The oldest day is overwritten once the
+    // week is full.
+    last_day_ = (last_day_ + 1) % kDaysInWeek;
+    daily_values_[last_day_] = {now_midnight, delta};
+    if (days_count_ < kDaysInWeek) {
+      days_count_++;
     }
   } else {
-    daily_values_.front().value += delta;
+    // The same day, or the clock was set back.
+    daily_values_[last_day_].value += delta;
   }
 
-  Save();
+  if (prefs_ && !save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, kSaveDelay, this, &WeeklyStorage::Save);
+  }
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = 0;
+  for (size_t i = 0; i < days_count_; i++) {
+    // Check only last continious days.
+    const DailyValue& daily_value = GetDailyValue(i);
+    if (daily_value.day > n_days_ago) {
+      sum += daily_value.value;
+    }
+  }
+  return sum;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return days_count_ == kDaysInWeek;
+}
+
+void WeeklyStorage::Flush() {
+  if (save_timer_.IsRunning()) {
+    save_timer_.Stop();
+    Save();
+  }
+}
+
+const WeeklyStorage::DailyValue& WeeklyStorage::GetDailyValue(
+    size_t days_ago) const {
+  DCHECK_LT(days_ago, days_count_);
+  return daily_values_[(last_day_ + kDaysInWeek - days_ago) % kDaysInWeek];
 }
 
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK_EQ(days_count_, 0u);
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
   }
+  // Saved values start from the last day.
+  std::array<DailyValue, kDaysInWeek> loaded_values;
+  size_t loaded_count = 0;
   for (auto it = list->begin(); it != list->end(); ++it) {
     const base::Value* day = it->FindKey("day");
     const base::Value* value = it->FindKey("value");
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (loaded_count == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    loaded_values[loaded_count++] = {
+        base::Time::FromDoubleT(day->GetDouble()),
+        static_cast<uint64_t>(value->GetDouble())};
   }
+
+  for (size_t i = 0; i < loaded_count; i++) {
+    daily_values_[loaded_count - 1 - i] = loaded_values[i];
+  }
+  days_count_ = loaded_count;
+  last_day_ = loaded_count > 0 ? loaded_count - 1 : 0;
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
-
-  ListPrefUpdate update(prefs_, pref_name_);
-  base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
-  list->Clear();
-  for (const auto& u : daily_values_) {
+  DCHECK_GT(days_count_, 0u);
+  DCHECK_LE(days_count_, kDaysInWeek);
+
+  base::ListValue list;
+  for (size_t i = 0; i < days_count_; i++) {
+    const DailyValue& daily_value = GetDailyValue(i);
     base::DictionaryValue value;
-    value.SetKey("day", base::Value(u.day.ToDoubleT()));
-    value.SetDoubleKey("value", u.value);
-    list->Append(std::move(value));
+    value.SetKey("day", base::Value(daily_value.day.ToDoubleT()));
+    value.SetDoubleKey("value", daily_value.value);
+    list.Append(std::move(value));
   }
+  prefs_->Set(pref_name_, list);
 }
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -19,9 +20,12 @@ class PrefService;
 
 // Mostly used by various P3A recorders - allows to track a sum of some
 // values added from time to time via |AddDelta| over a last week.
-// Requires |pref_name| to be already registered.
-// Feel free to improve and refactor it - templatize a stored value type,
-// change weekly interval or make a keyed service from it.
+// Requires |pref_name| to be already registered, |prefs| must outlive the
+// storage. Values are kept in memory and saved to prefs after a delay, so
+// profile bound storages should be obtained from |WeeklyStorageRegistry|
+// rather than created for every event.
+// Feel free to improve and refactor it - templatize a stored value type or
+// change weekly interval.
 class WeeklyStorage {
  public:
   WeeklyStorage(PrefService* prefs, const char* pref_name);
@@ -39,11 +43,19 @@ class WeeklyStorage {
   uint64_t GetWeeklySum() const;
   bool IsOneWeekPassed() const;
 
+  // Saves pending values right away.
+  void Flush();
+
  private:
   struct DailyValue {
     base::Time day;
     uint64_t value = 0ull;
   };
+  static constexpr size_t kDaysInWeek = 7;
+
+  // Returns the value |days_ago| days before the last saved day.
+  const DailyValue& GetDailyValue(size_t days_ago) const;
+
   void Load();
   void Save();
 
@@ -51,7 +63,13 @@ class WeeklyStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of daily values, |last_day_| is the index of the last saved
+  // day.
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  size_t last_day_ = 0;
+  size_t days_count_ = 0;
+
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -0,0 +1,33 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "base/logging.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+
+WeeklyStorageRegistry::WeeklyStorageRegistry(PrefService* prefs)
+    : prefs_(prefs) {
+  DCHECK(prefs_);
+}
+
+WeeklyStorageRegistry::~WeeklyStorageRegistry() = default;
+
+WeeklyStorage* WeeklyStorageRegistry::Get(const char* pref_name) {
+  DCHECK(prefs_);
+  auto it = storages_.find(pref_name);
+  if (it == storages_.end()) {
+    it = storages_.emplace(pref_name, nullptr).first;
+    // The key outlives the storage.
+    it->second = std::make_unique<WeeklyStorage>(prefs_, it->first.c_str());
+  }
+  return it->second.get();
+}
+
+void WeeklyStorageRegistry::Shutdown() {
+  // Storages save pending values on destruction.
+  storages_.clear();
+  prefs_ = nullptr;
+}
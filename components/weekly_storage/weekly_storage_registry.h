@@ -0,0 +1,40 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "components/keyed_service/core/keyed_service.h"
+
+class PrefService;
+class WeeklyStorage;
+
+// Keeps |WeeklyStorage| instances of a profile alive, so that callers
+// recording frequent events share one instance per pref, loaded once.
+// Pending values are saved on shutdown.
+class WeeklyStorageRegistry : public KeyedService {
+ public:
+  explicit WeeklyStorageRegistry(PrefService* prefs);
+  ~WeeklyStorageRegistry() override;
+
+  WeeklyStorageRegistry(const WeeklyStorageRegistry&) = delete;
+  WeeklyStorageRegistry& operator=(const WeeklyStorageRegistry&) = delete;
+
+  // Returns the storage backed by |pref_name|, which must be registered.
+  WeeklyStorage* Get(const char* pref_name);
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  PrefService* prefs_ = nullptr;
+  std::map<std::string, std::unique_ptr<WeeklyStorage>> storages_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
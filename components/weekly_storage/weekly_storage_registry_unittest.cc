@@ -0,0 +1,51 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "base/test/task_environment.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+constexpr char kFirstPrefName[] = "brave.weekly_test.first";
+constexpr char kSecondPrefName[] = "brave.weekly_test.second";
+}  // namespace
+
+class WeeklyStorageRegistryTest : public ::testing::Test {
+ public:
+  WeeklyStorageRegistryTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        registry_(&pref_service_) {
+    pref_service_.registry()->RegisterListPref(kFirstPrefName);
+    pref_service_.registry()->RegisterListPref(kSecondPrefName);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple pref_service_;
+  WeeklyStorageRegistry registry_;
+};
+
+TEST_F(WeeklyStorageRegistryTest, KeepsStoragesAlive) {
+  WeeklyStorage* first = registry_.Get(kFirstPrefName);
+  first->AddDelta(1);
+  EXPECT_EQ(first, registry_.Get(kFirstPrefName));
+  EXPECT_NE(first, registry_.Get(kSecondPrefName));
+
+  registry_.Get(kFirstPrefName)->AddDelta(1);
+  EXPECT_EQ(registry_.Get(kFirstPrefName)->GetWeeklySum(), 2u);
+  EXPECT_EQ(registry_.Get(kSecondPrefName)->GetWeeklySum(), 0u);
+}
+
+TEST_F(WeeklyStorageRegistryTest, SavesOnShutdown) {
+  registry_.Get(kFirstPrefName)->AddDelta(1);
+  EXPECT_TRUE(pref_service_.GetList(kFirstPrefName)->GetList().empty());
+
+  registry_.Shutdown();
+  EXPECT_EQ(pref_service_.GetList(kFirstPrefName)->GetList().size(), 1u);
+}
@@ -8,16 +8,24 @@
 #include <memory>
 #include <utility>
 
+#include "base/logging.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+constexpr char kPrefName[] = "brave.weekly_test";
+}  // namespace
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
-  WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
+  WeeklyStorageTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        clock_(new base::SimpleTestClock) {
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +34,21 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  // Recreates the storage from prefs, as on a browser restart.
+  void RestartStorage() {
+    auto clock = std::make_unique<base::SimpleTestClock>();
+    clock->SetNow(clock_->Now());
+    clock_ = clock.get();
+    state_.reset();
+    state_ = std::make_unique<WeeklyStorage>(&pref_service_, kPrefName,
+                                             std::move(clock));
+  }
+
+  size_t GetSavedDaysCount() {
+    return pref_service_.GetList(kPrefName)->GetList().size();
+  }
+
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -96,3 +119,71 @@ TEST_F(WeeklyStorageTest, InfrequentUsage) {
   state_->AddDelta(saving);
   EXPECT_EQ(state_->GetWeeklySum(), 2 * saving);
 }
+
+TEST_F(WeeklyStorageTest, SavesAfterDelay) {
+  uint64_t saving = 10000;
+  state_->AddDelta(saving);
+  state_->AddDelta(saving);
+  EXPECT_EQ(GetSavedDaysCount(), 0u);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(GetSavedDaysCount(), 1u);
+
+  // Values not saved yet are saved on destruction.
+  state_->AddDelta(saving);
+  RestartStorage();
+  EXPECT_EQ(state_->GetWeeklySum(), saving * 3);
+}
+
+TEST_F(WeeklyStorageTest, KeepsWeekAcrossRestarts) {
+  uint64_t saving = 10000;
+  for (int day = 0; day < 10; day++) {
+    clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(saving * (day + 1));
+  }
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+  const uint64_t sum = state_->GetWeeklySum();
+  EXPECT_EQ(sum, saving * (4 + 5 + 6 + 7 + 8 + 9 + 10));
+
+  RestartStorage();
+  EXPECT_EQ(GetSavedDaysCount(), 7u);
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+  EXPECT_EQ(state_->GetWeeklySum(), sum);
+
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  state_->AddDelta(saving);
+  EXPECT_EQ(state_->GetWeeklySum(), sum - saving * 4 + saving);
+}
+
+TEST_F(WeeklyStorageTest, HandlesClockSetBack) {
+  uint64_t saving = 10000;
+  state_->AddDelta(saving);
+  clock_->Advance(base::TimeDelta::FromDays(2));
+  state_->AddDelta(saving);
+
+  // Values recorded after the clock was set back are added to the last day.
+  clock_->Advance(-base::TimeDelta::FromDays(1));
+  state_->AddDelta(saving);
+  EXPECT_EQ(state_->GetWeeklySum(), saving * 3);
+
+  clock_->Advance(base::TimeDelta::FromDays(2));
+  state_->AddDelta(saving);
+  EXPECT_EQ(state_->GetWeeklySum(), saving * 4);
+}
+
+TEST_F(WeeklyStorageTest, AddsManyDeltas) {
+  const int kDeltasCount = 10000;
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kDeltasCount; i++) {
+    if (i % 1000 == 0)
+      clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(1);
+  }
+  LOG(INFO) << kDeltasCount << " AddDelta calls took "
+            << timer.Elapsed().InMicroseconds() << "us";
+
+  EXPECT_EQ(state_->GetWeeklySum(), 7000u);
+  EXPECT_EQ(GetSavedDaysCount(), 0u);
+  state_->Flush();
+  EXPECT_EQ(GetSavedDaysCount(), 7u);
+}